@@ -0,0 +1,111 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+//bump allocator for pugixml. While a ParseArena is alive, the pugixml allocations of its thread are cut from a few large
+//blocks and the frees pugixml makes along the way are ignored, the whole DOM is released in one step when the arena goes.
+//Other threads, and this one outside the lifetime of an arena, allocate with malloc and free as before
+//
+//  ParseArena arena;
+//  pugi::xml_document doc;     destroyed before the arena, declare it after
+
+#include <algorithm>
+#include <vector>
+#include <stddef.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+class ParseArena;
+
+//the arena pugixml allocates from on this thread, nullptr for malloc
+inline thread_local ParseArena* activeArena = nullptr;
+
+class ParseArena
+{
+public:
+    ParseArena() : mPrevious(activeArena)
+    {
+        activeArena = this;
+    }
+
+    ~ParseArena()
+    {
+        activeArena = mPrevious;
+        for(auto& block : mBlocks)
+            munmap(block.mStart, block.mSize);
+    }
+
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    void* allocate(size_t aSize)
+    {
+        size_t size = (aSize + alignment - 1) & ~(alignment - 1);
+        //the file buffer and other large requests get a block of their own, the current block is kept for the small ones
+        if(size > mNextBlockSize / 4)
+            return addBlock(size);
+        if(mUsed + size > mCapacity)
+        {
+            mCurrent = addBlock(mNextBlockSize);
+            if(!mCurrent)
+                return nullptr;
+            mUsed = 0;
+            mCapacity = mNextBlockSize;
+            mNextBlockSize = std::min(mNextBlockSize * 2, maxBlockSize);
+        }
+        char* pointer = mCurrent + mUsed;
+        mUsed += size;
+        return pointer;
+    }
+
+    bool owns(void* aPointer) const
+    {
+        char* pointer = static_cast<char*>(aPointer);
+        for(auto& block : mBlocks)
+        {
+            if(pointer >= block.mStart && pointer < block.mStart + block.mSize)
+                return true;
+        }
+        return false;
+    }
+
+    //for pugi::set_memory_management_functions
+    static void* allocateActive(size_t aSize)
+    {
+        return activeArena ? activeArena->allocate(aSize) : malloc(aSize);
+    }
+
+    static void deallocateActive(void* aPointer)
+    {
+        if(!activeArena || !activeArena->owns(aPointer))
+            free(aPointer);
+    }
+
+private:
+    struct Block {
+        char* mStart;
+        size_t mSize;
+    }typedef Block;
+
+    //blocks are mapped directly rather than taken from malloc, so they go back to the system when the arena is destroyed
+    char* addBlock(size_t aSize)
+    {
+        void* block = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(block == MAP_FAILED)
+            return nullptr;
+        mBlocks.push_back({static_cast<char*>(block), aSize});
+        return static_cast<char*>(block);
+    }
+
+    static constexpr size_t alignment = alignof(max_align_t);
+    //blocks double from 1 MB, so a DOM of any size takes a few dozen blocks at most
+    static constexpr size_t maxBlockSize = 64 << 20;
+
+    ParseArena* mPrevious;
+    std::vector<Block> mBlocks;
+    char* mCurrent = nullptr;
+    size_t mUsed = 0;
+    size_t mCapacity = 0;
+    size_t mNextBlockSize = 1 << 20;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "solver.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+
+//results are added here so the compiler cannot drop the benchmarked calls
+volatile double benchSink = 0;
+
+struct BenchResult {
+    std::string mFixture;
+    std::string mName;
+    //nanoseconds per call
+    double mMedian;
+    double mP95;
+    double mCallsPerSecond;
+}typedef BenchResult;
+
+double timeBatch(const std::function<void()>& aOperation, long long aCalls)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(long long i = 0; i < aCalls; ++i)
+        aOperation();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+//time aOperation in batches that run for about a millisecond each, so cheap calls are not lost in the clock resolution
+//the statistics are taken over the per-call time of every batch
+BenchResult runBenchmark(const std::string& aFixture, const std::string& aName, const std::function<void()>& aOperation)
+{
+    int samples = 31;
+    long long batch = 1;
+    while(batch < (1 << 24) && timeBatch(aOperation, batch) < 1e6)
+        batch *= 2;
+    timeBatch(aOperation, batch);
+
+    std::vector<double> perCall(samples);
+    for(int s = 0; s < samples; ++s)
+        perCall[s] = timeBatch(aOperation, batch) / batch;
+    std::sort(perCall.begin(), perCall.end());
+
+    BenchResult result;
+    result.mFixture = aFixture;
+    result.mName = aName;
+    result.mMedian = perCall[samples / 2];
+    result.mP95 = perCall[(int)ceil(0.95 * samples) - 1];
+    result.mCallsPerSecond = 1e9 / result.mMedian;
+    return result;
+}
+
+void printResult(const BenchResult& aResult)
+{
+    std::cout << std::left << std::setw(12) << aResult.mFixture << std::setw(34) << aResult.mName << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << aResult.mMedian << std::setw(14) << aResult.mP95 << std::setw(16) << aResult.mCallsPerSecond << std::endl;
+}
+
+int main()
+{
+    std::vector<std::string> fixtures = {"small.xml", "medium.xml", "large.xml"};
+
+    std::cout << std::left << std::setw(12) << "fixture" << std::setw(34) << "benchmark" << std::right
+              << std::setw(14) << "median ns" << std::setw(14) << "p95 ns" << std::setw(16) << "calls/s" << std::endl;
+
+    //the solver reports progress to the log of the context, which would be timed along with the calls
+    std::ostream quiet(nullptr);
+    for(auto& fixture : fixtures)
+    {
+        std::vector<BenchResult> results;
+        results.push_back(runBenchmark(fixture, "loadInstance", [&fixture, &quiet]() { benchSink = benchSink + (loadInstance(fixture, quiet) != nullptr); }));
+        SolverContext context(loadInstance(fixture, quiet));
+        context.mLog = &quiet;
+        const ProblemInstance& instance = *context.mInstance;
+
+        std::vector<std::tuple<int, int, int>> solution = createGreedySolution(instance);
+        if(solution.empty())
+            solution = createInitialSolution(context);
+
+        results.push_back(runBenchmark(fixture, "checkIfAllCoreHasTasks", [&instance, &solution]() { benchSink = benchSink + checkIfAllCoreHasTasks(instance, solution); }));
+        results.push_back(runBenchmark(fixture, "checkCoreDeadline", [&instance, &solution]() { benchSink = benchSink + checkCoreDeadline(instance, 0, 0, solution); }));
+        results.push_back(runBenchmark(fixture, "checkDeadline", [&instance, &solution]() { benchSink = benchSink + checkDeadline(instance, solution); }));
+        results.push_back(runBenchmark(fixture, "calculateLaxity", [&instance, &solution]() { benchSink = benchSink + calculateLaxity(instance, solution); }));
+
+        int n = 0;
+        results.push_back(runBenchmark(fixture, "selectRandomNeighbourhoodSolution", [&context, &solution, &n]() {
+            benchSink = benchSink + std::get<1>(selectRandomNeighbourhoodSolution(context, ++n, solution)[0]);
+        }));
+        CoreState state = buildCoreState(instance, solution);
+        results.push_back(runBenchmark(fixture, "randomRelocation+delta", [&context, &instance, &solution, &state]() {
+            Move move = randomRelocation(context, solution);
+            benchSink = benchSink + moveLaxityDelta(instance, move, solution) + moveIsFeasible(instance, move, solution, state);
+        }));
+        results.push_back(runBenchmark(fixture, "randomSwap+delta", [&context, &instance, &solution, &state]() {
+            Move move = randomSwap(context, solution);
+            benchSink = benchSink + moveLaxityDelta(instance, move, solution) + moveIsFeasible(instance, move, solution, state);
+        }));
+
+        results.push_back(runBenchmark(fixture, "rng", [&context]() { benchSink = benchSink + context.mRng(); }));
+        //what the annealing operators pay on every call to get a generator
+        results.push_back(runBenchmark(fixture, "random_device+mt19937 seeding", []() {
+            std::random_device dev;
+            std::mt19937 generator(dev());
+            benchSink = benchSink + generator();
+        }));
+
+        results.push_back(runBenchmark(fixture, "writeOutput", [&instance, &solution, &quiet]() { writeOutput(instance, solution, "bench.xml", false, quiet); }));
+        remove("solution_bench.xml");
+
+        for(auto& result : results)
+            printResult(result);
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef CMDLINE_HPP
+#define CMDLINE_HPP
+
+//argument parsing shared by the command line tools
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+//the items of a comma separated list, "a,b,c" gives a, b and c
+inline std::vector<std::string> splitList(const std::string& aList)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(aList);
+    std::string item;
+    while(std::getline(stream, item, ','))
+        items.push_back(item);
+    return items;
+}
+
+#endif
@@ -0,0 +1,225 @@
+#include "cmdline.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits.h>
+#include <stdio.h>
+#include <math.h>
+
+//synthetic Model files in the same format as small/medium/large.xml, for measuring how the solver scales
+
+struct GeneratorOptions {
+    long long mTasks = 1000;
+    int mMcps = 4;
+    int mMinCores = 2;
+    int mMaxCores = 4;
+    //total task utilization as a fraction of what the platform can hold, a core with factor f holds 1 / f
+    double mUtilization = 0.5;
+    std::vector<int> mPeriods = {5000, 10000, 20000, 40000, 80000};
+    std::vector<std::pair<double, double>> mFactors = {{0.5, 1}, {0.7, 1}, {0.9, 1}, {1.1, 1}, {1.3, 1}, {1.4, 1}, {1.5, 1}};
+    unsigned mSeed = 1;
+    std::string mOutput = "generated.xml";
+}typedef GeneratorOptions;
+
+//UUniFast: aCount utilizations that sum to aTotal and are uniformly distributed over that simplex
+//draws with a task above aMax are discarded and redrawn, after a few tries the large ones are clipped
+std::vector<double> uunifast(long long aCount, double aTotal, double aMax, std::mt19937& aRandom)
+{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> utilizations(aCount);
+    for(int attempt = 0; attempt < 100; ++attempt)
+    {
+        double sum = aTotal;
+        bool valid = true;
+        for(long long i = 0; i < aCount - 1; ++i)
+        {
+            double next = sum * pow(uniform(aRandom), 1.0 / (aCount - 1 - i));
+            utilizations[i] = sum - next;
+            valid = valid && utilizations[i] <= aMax;
+            sum = next;
+        }
+        utilizations[aCount - 1] = sum;
+        if(valid && sum <= aMax)
+            return utilizations;
+    }
+
+    std::cout << "Could not draw utilizations below " << aMax << ", clipping" << std::endl;
+    for(auto& utilization : utilizations)
+        utilization = std::min(utilization, aMax);
+    return utilizations;
+}
+
+bool parseArguments(int argc, char* argv[], GeneratorOptions& aOptions)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(i + 1 >= argc)
+        {
+            std::cout << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if(arg == "--tasks")
+            aOptions.mTasks = std::stoll(value);
+        else if(arg == "--mcps")
+            aOptions.mMcps = std::stoi(value);
+        else if(arg == "--cores")
+        {
+            //either a fixed count or min-max
+            size_t dash = value.find('-');
+            aOptions.mMinCores = std::stoi(value.substr(0, dash));
+            aOptions.mMaxCores = dash == std::string::npos ? aOptions.mMinCores : std::stoi(value.substr(dash + 1));
+        }
+        else if(arg == "--utilization")
+            aOptions.mUtilization = std::stod(value);
+        else if(arg == "--periods")
+        {
+            if(value == "harmonic")
+                aOptions.mPeriods = {5000, 10000, 20000, 40000, 80000};
+            else if(value == "nonharmonic")
+                aOptions.mPeriods = {5000, 7000, 11000, 13000, 20000, 30000, 50000};
+            else
+            {
+                aOptions.mPeriods.clear();
+                for(auto& period : splitList(value))
+                    aOptions.mPeriods.push_back(std::stoi(period));
+            }
+        }
+        else if(arg == "--factors")
+        {
+            //factor or factor:weight, comma separated
+            aOptions.mFactors.clear();
+            for(auto& factor : splitList(value))
+            {
+                size_t colon = factor.find(':');
+                double weight = colon == std::string::npos ? 1.0 : std::stod(factor.substr(colon + 1));
+                aOptions.mFactors.push_back(std::make_pair(std::stod(factor.substr(0, colon)), weight));
+            }
+        }
+        else if(arg == "--seed")
+            aOptions.mSeed = std::stoul(value);
+        else if(arg == "--out")
+            aOptions.mOutput = value;
+        else
+        {
+            std::cout << "Unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if(aOptions.mTasks < 1 || aOptions.mMcps < 1 || aOptions.mMinCores < 1 || aOptions.mMaxCores < aOptions.mMinCores || aOptions.mPeriods.empty() || aOptions.mFactors.empty())
+    {
+        std::cout << "Invalid options" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    GeneratorOptions options;
+    if(!parseArguments(argc, argv, options))
+    {
+        std::cout << "Usage: Generator [--tasks N] [--mcps M] [--cores C|MIN-MAX] [--utilization U] [--periods harmonic|nonharmonic|P1,P2,...]"
+                  << " [--factors F1[:W1],F2[:W2],...] [--seed S] [--out FILE]" << std::endl;
+        return -1;
+    }
+
+    std::mt19937 random(options.mSeed);
+
+    std::uniform_int_distribution<int> generateCores(options.mMinCores, options.mMaxCores);
+    std::vector<double> weights;
+    for(auto& factor : options.mFactors)
+        weights.push_back(factor.second);
+    std::discrete_distribution<int> generateFactor(weights.begin(), weights.end());
+
+    std::vector<std::vector<double>> platform(options.mMcps);
+    double capacity = 0;
+    for(auto& mcp : platform)
+    {
+        mcp.resize(generateCores(random));
+        for(auto& factor : mcp)
+        {
+            factor = options.mFactors[generateFactor(random)].first;
+            capacity += 1.0 / factor;
+        }
+    }
+
+    double target = options.mUtilization * capacity;
+    std::vector<double> utilizations = uunifast(options.mTasks, target, 1.0, random);
+    std::uniform_int_distribution<int> generatePeriod(0, options.mPeriods.size() - 1);
+    std::vector<int> periods(options.mTasks);
+    for(auto& period : periods)
+        period = options.mPeriods[generatePeriod(random)];
+
+    //a WCET is a whole number of at least 1, with many tasks the utilization of a task times its period rounds far off
+    //the draw, so the periods are scaled up by tens until the rounded WCETs hold the target utilization to within 1%
+    auto wcetOf = [&utilizations, &periods](long long aTask, long long aScale) {
+        return std::max(1LL, (long long)llround(utilizations[aTask] * periods[aTask] * aScale));
+    };
+    int longestPeriod = *std::max_element(options.mPeriods.begin(), options.mPeriods.end());
+    long long scale = 1;
+    double utilization = 0;
+    while(true)
+    {
+        utilization = 0;
+        for(long long i = 0; i < options.mTasks; ++i)
+            utilization += (double)wcetOf(i, scale) / ((double)periods[i] * scale);
+        if(fabs(utilization - target) <= 0.01 * target)
+            break;
+        if((double)longestPeriod * scale * 10 > INT_MAX)
+        {
+            std::cout << options.mTasks << " tasks cannot reach utilization " << target << " on this platform, the rounded WCETs give "
+                      << utilization << " with periods scaled by " << scale << std::endl;
+            return -1;
+        }
+        scale *= 10;
+    }
+
+    //formatted into one buffer and written in one go, a million tasks are about 60 MB
+    std::string out;
+    out.reserve(options.mTasks * 64 + 1024);
+    char line[160];
+    out += "<Model>\n  <Application>\n";
+    for(long long i = 0; i < options.mTasks; ++i)
+    {
+        long long period = periods[i] * scale;
+        snprintf(line, sizeof(line), "    <Task Deadline=\"%lld\" Id=\"%lld\" Period=\"%lld\" WCET=\"%lld\" />\n", period, i, period, wcetOf(i, scale));
+        out += line;
+    }
+    out += "  </Application>\n  <Platform>\n";
+    for(unsigned m = 0; m < platform.size(); ++m)
+    {
+        snprintf(line, sizeof(line), "    <MCP Id=\"%u\">\n", m);
+        out += line;
+        for(unsigned c = 0; c < platform[m].size(); ++c)
+        {
+            snprintf(line, sizeof(line), "      <Core Id=\"%u\" WCETFactor=\"%g\" />\n", c, platform[m][c]);
+            out += line;
+        }
+        out += "    </MCP>\n";
+    }
+    out += "  </Platform>\n</Model>\n";
+
+    FILE* file = fopen(options.mOutput.c_str(), "wb");
+    if(!file || fwrite(out.data(), 1, out.size(), file) != out.size())
+    {
+        std::cout << "Could not write " << options.mOutput << std::endl;
+        if(file)
+            fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    std::cout << options.mOutput << ": " << options.mTasks << " tasks on " << options.mMcps << " MCPs, utilization " << utilization << " (target " << target << ") of capacity " << capacity;
+    if(scale > 1)
+        std::cout << ", periods scaled by " << scale;
+    std::cout << std::endl;
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include "cmdline.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+//solution quality per time budget: runs solver binaries over instances x seeds x time budgets. Every budget is a separate
+//run and only its final laxity is kept, so the table gives one endpoint per budget rather than the trajectory of one run,
+//and the time to target is the smallest budget whose run gets within a tolerance of the best known laxity, as fine as the
+//budgets given. With a candidate binary every instance, budget and seed is compared pairwise
+//
+//  Harness --baseline ./Exercise1 --candidate ./Exercise1.new --instances medium.xml,large.xml --budgets 0.25,0.5,1,2
+
+struct HarnessOptions {
+    std::vector<std::string> mBinaries;
+    std::vector<std::string> mInstances = {"small.xml", "medium.xml", "large.xml"};
+    std::vector<unsigned> mSeeds = {1, 2, 3, 4, 5};
+    std::vector<double> mBudgets = {0.1, 0.5, 1, 2};
+    std::string mMode = "sa";
+    std::string mExtraArguments;
+    //a run reaches the target when it is within this fraction of the best laxity any run found on the instance
+    double mTargetTolerance = 0.0005;
+    std::string mOutput = "harness_results.csv";
+}typedef HarnessOptions;
+
+struct HarnessRun {
+    int mBinary;
+    std::string mInstance;
+    double mBudget;
+    unsigned mSeed;
+    bool mValid;
+    double mLaxity;
+    double mGap;
+    double mWallSeconds;
+}typedef HarnessRun;
+
+double median(std::vector<double> aValues)
+{
+    if(aValues.empty())
+        return NAN;
+    std::sort(aValues.begin(), aValues.end());
+    size_t middle = aValues.size() / 2;
+    return aValues.size() % 2 ? aValues[middle] : (aValues[middle - 1] + aValues[middle]) / 2;
+}
+
+//run one solve and read the final laxity from the "Final: laxity L, gap G%" line the solver prints
+HarnessRun runSolver(const HarnessOptions& aOptions, int aBinary, const std::string& aInstance, double aBudget, unsigned aSeed)
+{
+    HarnessRun run = {aBinary, aInstance, aBudget, aSeed, false, NAN, NAN, 0};
+
+    std::ostringstream command;
+    command << aOptions.mBinaries[aBinary] << " " << aInstance << " --mode " << aOptions.mMode << " --seed " << aSeed
+            << " --time-limit " << aBudget << " " << aOptions.mExtraArguments << " 2>&1";
+
+    auto start = std::chrono::steady_clock::now();
+    FILE* pipe = popen(command.str().c_str(), "r");
+    if(!pipe)
+        return run;
+
+    char line[4096];
+    while(fgets(line, sizeof(line), pipe))
+    {
+        long long laxity;
+        double gap;
+        if(sscanf(line, "Final: laxity %lld, gap %lf%%", &laxity, &gap) == 2)
+        {
+            run.mValid = true;
+            run.mLaxity = laxity;
+            run.mGap = gap;
+        }
+    }
+    run.mValid = pclose(pipe) == 0 && run.mValid;
+    run.mWallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return run;
+}
+
+bool parseArguments(int argc, char* argv[], HarnessOptions& aOptions)
+{
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+        if(arg == "--baseline")
+            aOptions.mBinaries.insert(aOptions.mBinaries.begin(), value);
+        else if(arg == "--candidate")
+            aOptions.mBinaries.push_back(value);
+        else if(arg == "--instances")
+            aOptions.mInstances = splitList(value);
+        else if(arg == "--seeds")
+        {
+            aOptions.mSeeds.clear();
+            for(auto& seed : splitList(value))
+                aOptions.mSeeds.push_back(std::stoul(seed));
+        }
+        else if(arg == "--budgets")
+        {
+            aOptions.mBudgets.clear();
+            for(auto& budget : splitList(value))
+                aOptions.mBudgets.push_back(std::stod(budget));
+            std::sort(aOptions.mBudgets.begin(), aOptions.mBudgets.end());
+        }
+        else if(arg == "--mode")
+            aOptions.mMode = value;
+        else if(arg == "--args")
+            aOptions.mExtraArguments = value;
+        else if(arg == "--target-tolerance")
+            aOptions.mTargetTolerance = std::stod(value);
+        else if(arg == "--out")
+            aOptions.mOutput = value;
+        else
+            return false;
+    }
+
+    return argc % 2 == 1 && !aOptions.mBinaries.empty() && aOptions.mBinaries.size() <= 2;
+}
+
+int main(int argc, char* argv[])
+{
+    HarnessOptions options;
+    if(!parseArguments(argc, argv, options))
+    {
+        std::cout << "Usage: Harness --baseline BINARY [--candidate BINARY] [--instances A,B] [--seeds 1,2] [--budgets 0.5,1]"
+                  << " [--mode MODE] [--args \"EXTRA SOLVER ARGUMENTS\"] [--target-tolerance F] [--out FILE]" << std::endl;
+        return -1;
+    }
+
+    std::vector<HarnessRun> runs;
+    for(auto& instance : options.mInstances)
+        for(double budget : options.mBudgets)
+            for(unsigned seed : options.mSeeds)
+                for(unsigned binary = 0; binary < options.mBinaries.size(); ++binary)
+                {
+                    runs.push_back(runSolver(options, binary, instance, budget, seed));
+                    const HarnessRun& run = runs.back();
+                    std::cerr << options.mBinaries[binary] << " " << instance << " budget " << budget << " seed " << seed << ": "
+                              << (run.mValid ? std::to_string((long long)run.mLaxity) : std::string("failed")) << std::endl;
+                }
+
+    std::ofstream csv(options.mOutput);
+    csv << "binary,instance,mode,budget,seed,valid,laxity,gap_percent,wall_seconds\n";
+    for(auto& run : runs)
+        csv << options.mBinaries[run.mBinary] << ',' << run.mInstance << ',' << options.mMode << ',' << run.mBudget << ',' << run.mSeed << ','
+            << run.mValid << ',' << std::setprecision(12) << run.mLaxity << ',' << run.mGap << ',' << run.mWallSeconds << '\n';
+
+    std::cout << std::fixed;
+    for(auto& instance : options.mInstances)
+    {
+        double bestLaxity = -INFINITY;
+        for(auto& run : runs)
+            if(run.mInstance == instance && run.mValid)
+                bestLaxity = std::max(bestLaxity, run.mLaxity);
+        double target = bestLaxity - fabs(bestLaxity) * options.mTargetTolerance;
+
+        std::cout << "\n" << instance << " (mode " << options.mMode << ", target laxity " << std::setprecision(0) << target << ")\n";
+        std::cout << std::setw(10) << "budget s";
+        for(size_t k = 0; k < options.mBinaries.size(); ++k)
+            std::cout << std::setw(22) << "median final laxity" << std::setw(12) << "gap %";
+        if(options.mBinaries.size() == 2)
+            std::cout << std::setw(16) << "median delta" << std::setw(14) << "win/tie/loss";
+        std::cout << "\n";
+
+        //the runs of every binary and seed, in budget order
+        std::map<std::pair<int, unsigned>, std::vector<const HarnessRun*>> budgetRuns;
+        for(double budget : options.mBudgets)
+        {
+            std::cout << std::setw(10) << std::setprecision(2) << budget;
+            std::vector<std::map<unsigned, double>> laxities(options.mBinaries.size());
+            for(unsigned binary = 0; binary < options.mBinaries.size(); ++binary)
+            {
+                std::vector<double> values;
+                std::vector<double> gaps;
+                for(auto& run : runs)
+                {
+                    if(run.mInstance != instance || run.mBudget != budget || run.mBinary != (int)binary)
+                        continue;
+                    budgetRuns[std::make_pair(binary, run.mSeed)].push_back(&run);
+                    if(!run.mValid)
+                        continue;
+                    values.push_back(run.mLaxity);
+                    gaps.push_back(run.mGap);
+                    laxities[binary][run.mSeed] = run.mLaxity;
+                }
+                std::cout << std::setw(22) << std::setprecision(0) << median(values) << std::setw(12) << std::setprecision(4) << median(gaps);
+            }
+
+            if(options.mBinaries.size() == 2)
+            {
+                std::vector<double> deltas;
+                int wins = 0, ties = 0, losses = 0;
+                for(auto& baseline : laxities[0])
+                {
+                    auto candidate = laxities[1].find(baseline.first);
+                    if(candidate == laxities[1].end())
+                        continue;
+                    double delta = candidate->second - baseline.second;
+                    deltas.push_back(delta);
+                    if(delta > 0.5)
+                        wins++;
+                    else if(delta < -0.5)
+                        losses++;
+                    else
+                        ties++;
+                }
+                std::cout << std::setw(16) << std::setprecision(0) << median(deltas) << std::setw(14)
+                          << (std::to_string(wins) + "/" + std::to_string(ties) + "/" + std::to_string(losses));
+            }
+            std::cout << "\n";
+        }
+
+        for(unsigned binary = 0; binary < options.mBinaries.size(); ++binary)
+        {
+            std::vector<double> times;
+            int missed = 0;
+            for(unsigned seed : options.mSeeds)
+            {
+                double reached = NAN;
+                for(const HarnessRun* run : budgetRuns[std::make_pair(binary, seed)])
+                {
+                    if(run->mValid && run->mLaxity >= target)
+                    {
+                        reached = run->mBudget;
+                        break;
+                    }
+                }
+                if(isnan(reached))
+                    missed++;
+                else
+                    times.push_back(reached);
+            }
+            std::cout << "smallest budget to target, " << options.mBinaries[binary] << ": median " << std::setprecision(2) << median(times)
+                      << " s, not reached in " << missed << " of " << options.mSeeds.size() << " seeds\n";
+        }
+    }
+
+    std::cout << "\nraw runs written to " << options.mOutput << std::endl;
+    return 0;
+}
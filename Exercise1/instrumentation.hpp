@@ -0,0 +1,137 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+//hot path timers and counters, only compiled in with -DSOLVER_PROFILE (make PROFILE=1)
+//without it PROFILE_SCOPE expands to nothing, so normal builds pay nothing
+#ifdef SOLVER_PROFILE
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum ProfilePhase {
+    PhaseParse,
+    PhaseConstruction,
+    PhaseSearch,
+    PhaseFeasibility,
+    PhaseCost,
+    PhaseNeighbour,
+    PhaseOutput,
+    PhaseCount
+};
+
+//every thread counts into its own block, the blocks stay alive after their thread ends so they can be summed at exit
+struct PhaseCounters {
+    unsigned long long mCalls[PhaseCount] = {};
+    unsigned long long mTicks[PhaseCount] = {};
+    //open scopes of every phase, only the outermost one is timed so a check calling a check is not counted twice
+    int mDepth[PhaseCount] = {};
+}typedef PhaseCounters;
+
+inline unsigned long long profileTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct ProfileRegistry {
+    std::mutex mMutex;
+    std::vector<PhaseCounters*> mCounters;
+    //taken at the first registration, used to convert ticks to nanoseconds at exit
+    std::chrono::steady_clock::time_point mStartTime;
+    unsigned long long mStartTicks = 0;
+}typedef ProfileRegistry;
+
+inline ProfileRegistry& profileRegistry()
+{
+    static ProfileRegistry* registry = new ProfileRegistry();
+    return *registry;
+}
+
+inline void printProfile()
+{
+    ProfileRegistry& registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - registry.mStartTime).count();
+    double elapsedTicks = (double)(profileTicks() - registry.mStartTicks);
+    double nsPerTick = elapsedTicks > 0 ? elapsedNs / elapsedTicks : 1.0;
+
+    const char* names[PhaseCount] = {"parse", "construction", "search", "feasibility", "cost", "neighbour", "output"};
+    std::printf("%-14s %14s %14s %12s\n", "phase", "calls", "total ms", "ns/call");
+    for(int phase = 0; phase < PhaseCount; ++phase)
+    {
+        unsigned long long calls = 0;
+        unsigned long long ticks = 0;
+        for(PhaseCounters* counters : registry.mCounters)
+        {
+            calls += counters->mCalls[phase];
+            ticks += counters->mTicks[phase];
+        }
+        double ns = ticks * nsPerTick;
+        std::printf("%-14s %14llu %14.3f %12.1f\n", names[phase], calls, ns / 1e6, calls ? ns / calls : 0.0);
+    }
+    std::printf("(search includes the feasibility, cost and neighbour time spent inside the engines)\n");
+}
+
+inline PhaseCounters& threadCounters()
+{
+    thread_local PhaseCounters* counters = nullptr;
+    if(!counters)
+    {
+        counters = new PhaseCounters();
+        ProfileRegistry& registry = profileRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        if(registry.mCounters.empty())
+        {
+            registry.mStartTime = std::chrono::steady_clock::now();
+            registry.mStartTicks = profileTicks();
+            std::atexit(printProfile);
+        }
+        registry.mCounters.push_back(counters);
+    }
+    return *counters;
+}
+
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(ProfilePhase aPhase) : mCounters(threadCounters()), mPhase(aPhase)
+    {
+        if(mCounters.mDepth[mPhase]++ == 0)
+            mStart = profileTicks();
+    }
+
+    ~ScopedTimer()
+    {
+        if(--mCounters.mDepth[mPhase] == 0)
+        {
+            mCounters.mTicks[mPhase] += profileTicks() - mStart;
+            mCounters.mCalls[mPhase]++;
+        }
+    }
+
+private:
+    PhaseCounters& mCounters;
+    ProfilePhase mPhase;
+    unsigned long long mStart = 0;
+};
+
+#define PROFILE_SCOPE(phase) ScopedTimer profileTimer(phase)
+
+#else
+
+#define PROFILE_SCOPE(phase)
+
+#endif
+
+#endif
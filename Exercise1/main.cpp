@@ -1,365 +1,236 @@
-#include "pugixml.hpp"
+#include "taskalloc.hpp"
+#include "server.hpp"
+#include "threadpool.hpp"
 
 #include <iostream>
-#include <random>
-#include <utility>
-#include <vector>
+#include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <map>
 #include <string>
-#include <tuple>
+#include <vector>
+#include <glob.h>
 #include <math.h>
+#include <stdio.h>
 
-struct Task {
-    int mDeadline;
-    int mId;
-    int mPeriod;
-    double mWcet;
-    double mPriority;
-}typedef Task;
-
-struct Core {
-    int mId;
-    double mWcetFactor;
-}typedef Core;
-
-struct MCP {
-    int mId;
-    std::vector<Core> mCores;
-}typedef MCP;
-
-std::vector<Task> tasks;
-std::vector<MCP> platform;
-
-int deadlineSum = 0;
-
-//read in the html file and save the data
-bool readIn(std::string fileName)
+//the instances of a batch, either a glob pattern or a file with one instance path per line
+std::vector<std::string> batchInstances(const std::string& aSource)
 {
-    pugi::xml_document doc;
-
-    pugi::xml_parse_result result = doc.load_file(fileName.c_str());
-    if(!result)
-    {
-        std::cout << "Didn't find the specified file" << std::endl;
-        return false;
-    }
-
-    for(pugi::xml_node readinTask : doc.child("Model").child("Application").children("Task"))
+    std::vector<std::string> instances;
+    if(aSource.find_first_of("*?[") != std::string::npos)
     {
-        Task t;
-        t.mDeadline = readinTask.attribute("Deadline").as_int();
-        t.mId = readinTask.attribute("Id").as_int();
-        t.mPeriod = readinTask.attribute("Period").as_int();
-        t.mWcet = readinTask.attribute("WCET").as_int();
-        t.mPriority = 1.0 / (double)t.mDeadline;
-
-        tasks.push_back(t);
-
-        deadlineSum += t.mDeadline;
+        glob_t matches;
+        if(glob(aSource.c_str(), 0, nullptr, &matches) == 0)
+        {
+            for(size_t i = 0; i < matches.gl_pathc; ++i)
+                instances.push_back(matches.gl_pathv[i]);
+        }
+        globfree(&matches);
+        return instances;
     }
 
-    for(pugi::xml_node readinMCP : doc.child("Model").child("Platform").children("MCP"))
+    std::ifstream list(aSource);
+    std::string line;
+    while(std::getline(list, line))
     {
-        MCP mcp;
-        mcp.mId = readinMCP.attribute("Id").as_int();
-        for(pugi::xml_node readinCore : readinMCP.children())
-        {
-            Core c;
-            c.mId = readinCore.attribute("Id").as_int();
-            c.mWcetFactor = readinCore.attribute("WCETFactor").as_double();
-            mcp.mCores.push_back(c);
-        }
-        platform.push_back(mcp);
+        if(!line.empty() && line[0] != '#')
+            instances.push_back(line);
     }
-    std::cout << "Read in success" << std::endl;
-    return true;
+    return instances;
 }
 
-bool checkIfAllCoreHasTasks(std::vector<std::tuple<int, int, int>> solution)
+std::string jsonString(const std::string& aText)
 {
-    for(unsigned i = 0; i < platform.size(); ++i)
+    std::string quoted = "\"";
+    for(char c : aText)
     {
-        for(unsigned j = 0; j < platform.at(i).mCores.size(); ++j)
+        if((unsigned char)c < 0x20)
         {
-            if(std::find_if(solution.begin(), solution.end(), [i, j](std::tuple<int, int, int> element){
-                return std::get<1>(element) == i && std::get<2>(element) == j;
-                }) == solution.end())
-                return false;
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+            quoted += escaped;
+            continue;
         }
+        if(c == '"' || c == '\\')
+            quoted += '\\';
+        quoted += c;
     }
-
-    return true;
+    return quoted + "\"";
 }
 
-//calculate greatest common divisor
-long long gcd(long long int a, long long int b)
+//JSON has no inf or nan, a number that is not finite is written as null
+std::string jsonNumber(double aValue)
 {
-    if(b == 0)
-        return a;
-    return gcd(b, a % b);
+    if(!isfinite(aValue))
+        return "null";
+    std::ostringstream number;
+    number.precision(12);
+    number << aValue;
+    return number.str();
 }
 
-//calculate least common multiple
-long long lcm(long long a, long long b)
+int main(int argc, char* argv[])
 {
-    return (a / gcd(a, b)) * b;
-}
-
-//See if the tasks on a core meet the deadline
-bool checkCoreDeadline(int i, int j, std::vector<std::tuple<int, int, int>> aSolution)
-{
-    std::vector<int> taskIDs;
-    for(auto& element : aSolution)
-    {
-        if(std::get<1>(element) == i && std::get<2>(element))
+    //add file path here
+    std::string filepath = "large.xml";
+    SolveOptions options;
+    //the settings every solve starts from, each solve gets its own copy with the instance filled in
+    SolverContext settings(nullptr);
+    //glob pattern or list file of instances to solve, every one with the full --time-limit
+    std::string batch;
+    std::string summaryPath = "batch_summary.jsonl";
+    //number of batch instances solved at the same time, they share the --threads workers, so each gets --threads / jobs
+    unsigned jobs = 1;
+    //with --seed every instance starts from the same generator state, so a batch result does not depend on the order
+    bool seeded = false;
+    //unix domain socket to serve solve requests on instead of solving once
+    std::string socketPath;
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg == "--mode" && i + 1 < argc)
+            options.mMode = argv[++i];
+        else if(arg == "--polish")
+            options.mPolish = true;
+        else if(arg == "--print-solution")
+            options.mPrintSolution = true;
+        else if(arg == "--warm-start" && i + 1 < argc)
+            options.mWarmStart = argv[++i];
+        else if(arg == "--delta" && i + 1 < argc)
+            options.mDelta = argv[++i];
+        else if(arg == "--grasp" && i + 1 < argc)
+            options.mGraspCount = std::stoi(argv[++i]);
+        else if(arg == "--gap" && i + 1 < argc)
+            settings.mTargetGap = std::stod(argv[++i]);
+        else if(arg == "--exact-time-limit" && i + 1 < argc)
+            settings.mExactTimeLimit = std::stod(argv[++i]);
+#ifdef SA_TELEMETRY
+        else if(arg == "--trace" && i + 1 < argc)
+            settings.mTracePath = argv[++i];
+        else if(arg == "--trace-every" && i + 1 < argc)
+            settings.mTraceEvery = std::max(1, std::stoi(argv[++i]));
+        else if(arg == "--trace-binary")
+            settings.mTraceBinary = true;
+#else
+        else if(arg == "--trace" || arg == "--trace-every" || arg == "--trace-binary")
         {
-            taskIDs.push_back(std::get<0>(element));
+            std::cout << "SA telemetry is not compiled in, rebuild with make TELEMETRY=1" << std::endl;
+            return -1;
         }
-    }
-
-    long long commonDeadline = tasks.at(taskIDs.at(0)).mDeadline;
-    if(taskIDs.size() > 1)
-    {
-        for(unsigned int i = 1; i < taskIDs.size(); ++i)
+#endif
+        else if(arg == "--seed" && i + 1 < argc)
         {
-            commonDeadline = lcm(commonDeadline, tasks.at(taskIDs.at(i)).mDeadline);
+            seeded = true;
+            settings.mRng.seed(std::stoul(argv[++i]));
         }
+        else if(arg == "--time-limit" && i + 1 < argc)
+            settings.mTimeBudget = std::stod(argv[++i]);
+        else if(arg == "--threads" && i + 1 < argc)
+            settings.mThreadCount = std::max(1, std::stoi(argv[++i]));
+        else if(arg == "--batch" && i + 1 < argc)
+            batch = argv[++i];
+        else if(arg == "--summary" && i + 1 < argc)
+            summaryPath = argv[++i];
+        else if(arg == "--jobs" && i + 1 < argc)
+            jobs = std::max(1, std::stoi(argv[++i]));
+        else if(arg == "--serve" && i + 1 < argc)
+            socketPath = argv[++i];
+        else
+            filepath = arg;
     }
 
-    long long resourceSum = 0;
-
-    for(unsigned int i = 0; i < taskIDs.size(); ++i)
+    if(!options.mDelta.empty() && options.mWarmStart.empty())
     {
-        resourceSum += tasks.at(taskIDs.at(i)).mDeadline / commonDeadline * tasks.at(taskIDs.at(i)).mWcet;
+        std::cout << "--delta needs the solution it changes, given with --warm-start" << std::endl;
+        return -1;
     }
 
-    if(resourceSum > commonDeadline)
-    {
-        return false;
-    }
-    else
-    {
-        return true;
-    }
-}
+    if(!socketPath.empty())
+        return runServer(socketPath, options, settings);
 
-bool checkDeadline(std::vector<std::tuple<int, int, int>> aSolution)
-{
-    for(unsigned i = 0; i < platform.size(); ++i)
+    if(batch.empty())
     {
-        for(unsigned j = 0; j < platform.at(i).mCores.size(); ++j)
-        {
-            if(!checkCoreDeadline(i, j, aSolution))
-            {
-                return false;
-            }
-        }
+        SolverContext context = settings;
+        context.mInstance = loadInstance(filepath, std::cout, context.mThreadCount);
+        if(!context.mInstance)
+            return -1;
+        return solve(context, filepath, options).mSolved ? 0 : -1;
     }
 
-    return true;
-}
-
-bool check(std::vector<std::tuple<int, int, int>> aSolution)
-{
-    if(!checkIfAllCoreHasTasks(aSolution))
-        return false;
-    if(!checkDeadline(aSolution))
-        return false;
-    return true;
-}
-
-//create an initial solution, where in the vector the first is task id, second mcpid third coreid
-std::vector<std::tuple<int, int, int>> createInitialSolution()
-{
-    std::vector<std::tuple<int, int, int>> solution;
-
-    std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_int_distribution<std::mt19937::result_type> mcpRandom(0, platform.size()-1);
-    while(!check(solution))
+    if(!options.mWarmStart.empty())
     {
-        solution.clear();
-        for(unsigned i = 0; i < tasks.size(); ++i)
-        {
-            int mcp = mcpRandom(rng);
-            std::uniform_int_distribution<std::mt19937::result_type> coreRandom(0, platform.at(mcp).mCores.size() - 1);
-            int core = coreRandom(rng);
-
-            solution.push_back(std::make_tuple(i, mcp, core));
-        }
+        std::cout << "--warm-start and --delta take a single instance, not a batch" << std::endl;
+        return -1;
     }
 
-    std::cout << "Initial solution created" << std::endl;
-    return solution;
-}
-
-double calculateLaxity(std::vector<std::tuple<int, int, int>> aSolution)
-{
-    double sum = 0;
-    for(auto& element : aSolution)
+    std::vector<std::string> instances = batchInstances(batch);
+    if(instances.empty())
     {
-        sum += platform.at(std::get<1>(element)).mCores.at(std::get<2>(element)).mWcetFactor * tasks.at(std::get<0>(element)).mWcet;
+        std::cout << "No instances in " << batch << std::endl;
+        return -1;
     }
 
-    return deadlineSum - sum;
-}
-
-//swap two tasks
-std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodSwap(std::vector<std::tuple<int, int, int>> solution) 
-{
-    std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_int_distribution<std::mt19937::result_type> generate(0, solution.size() - 1);
-    unsigned i = generate(rng);
-    unsigned j = generate(rng);
-
-    std::swap(std::get<0>(solution[i]), std::get<0>(solution[j]));
-    return solution;
-}
-
-//move a task from one core to an other
-std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodMove(std::vector<std::tuple<int, int, int>> solution) 
-{
-    int counter = 0;
-    std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_int_distribution<std::mt19937::result_type> generate_mcp(0, platform.size() - 1);
-    std::uniform_int_distribution<std::mt19937::result_type> generate_task(0, tasks.size() - 1);
-
-    std::vector<std::tuple<int, int, int>> newSolution = solution;
-    do {
-        unsigned mcp = generate_mcp(rng);
-        std::uniform_int_distribution<std::mt19937::result_type> generate_core(0, platform.at(mcp).mCores.size() - 1);
-        unsigned core = generate_core(rng);
-        unsigned task = generate_task(rng);
-
-
-
-        std::get<1>(newSolution[task]) = mcp;
-        std::get<2>(newSolution[task]) = core;
-        counter++;
-
-        if (checkIfAllCoreHasTasks(newSolution))
-        {
-            return newSolution;
-        }
-
-    } while (counter < 50);
-
-    return selectRandomNeighbourhoodSwap(solution);
-}
-
-std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodSolution(int random, std::vector<std::tuple<int, int, int>> solution) 
-{
-    if (random % 2 == 0) 
+    std::ofstream summary(summaryPath);
+    if(!summary)
     {
-        return selectRandomNeighbourhoodMove(solution);
+        std::cout << "Could not write " << summaryPath << std::endl;
+        return -1;
     }
-    return selectRandomNeighbourhoodSwap(solution);
-}
-
-bool calculateProbability(double delta, double temp) 
-{
-    std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_real_distribution<double> generate(0.0, 1.0);
-
-    double exponential = exp((-1 / temp) * delta);
-    double probability = generate(rng);
-    return exponential >= probability;
-}
-
 
-std::vector<std::tuple<int, int, int>> runSimulatedAnnealing(std::vector<std::tuple<int, int, int>> &initialSolution)
-{
-    double temp = 30000000;
-    double alpha = 0.995;
-    int n = 0;
-    double delta = 0.0;
-    double solutionLaxity = 0.0;
-    double randomSolutionLaxity = 0.0;
-    std::vector<std::tuple<int, int, int>> solution = initialSolution;
-    while (temp > 1) 
-    {
-        // check deadlines are met
-        // if deadlines are not met, do not change temperature, generate new random solution
-        n++;
-        std::vector<std::tuple<int, int, int>> randomSolution;
-        do {
-            randomSolution = selectRandomNeighbourhoodSolution(n, solution);
-        } while (!checkDeadline(randomSolution));
-
-        //if deadlines are met, run cost function to calculate laxity for both solutions
-        solutionLaxity = calculateLaxity(solution);
-        randomSolutionLaxity = calculateLaxity(randomSolution);
-
-        // calculate delta
-        delta = solutionLaxity - randomSolutionLaxity;
-
-        if (delta < 0 || calculateProbability(delta, temp))
+    //with more than one job the progress of the solves would interleave, so they are quiet and only the summary is written
+    //the lines are collected and written in instance order, the summary does not depend on which solve finishes first
+    std::vector<std::string> lines(instances.size());
+    std::vector<char> solved(instances.size(), 0);
+    //an instance listed more than once gets the position of every entry in its solution files, solution_large.2.xml
+    std::map<std::string, int> listed;
+    for(auto& instance : instances)
+        listed[instance]++;
+    std::ostream quiet(nullptr);
+    unsigned concurrent = std::min<size_t>(jobs, instances.size());
+    ThreadPool pool(concurrent > 1 ? concurrent : 0);
+    //every job starts its own pool for the parallel engines, the jobs split the threads instead of each taking all of them
+    unsigned jobThreads = std::max(1u, settings.mThreadCount / concurrent);
+    pool.parallelFor(instances.size(), [&](int i) {
+        SolverContext context = settings;
+        context.mThreadCount = jobThreads;
+        if(!seeded)
+            context.mRng.seed(std::random_device{}());
+        if(jobs > 1)
+            context.mLog = &quiet;
+        context.mInstance = loadInstance(instances[i], *context.mLog, context.mThreadCount);
+        SolveOptions instanceOptions = options;
+        if(listed.at(instances[i]) > 1)
+            instanceOptions.mSolutionTag = std::to_string(i + 1);
+        //every instance gets its own trace, trace.small.csv, with the position added for an instance listed more than once
+        if(!context.mTracePath.empty())
         {
-            solution = randomSolution;
+            std::string name = instances[i].substr(instances[i].find_last_of('/') + 1);
+            name = name.substr(0, name.find_last_of('.'));
+            if(!instanceOptions.mSolutionTag.empty())
+                name += "." + instanceOptions.mSolutionTag;
+            context.mTracePath = taggedPath(context.mTracePath, name);
         }
-        temp *= alpha;
-    }
-
-    return solution;
-}
-
-//save solution to xml
-void writeOutput(std::vector<std::tuple<int, int, int>> aSolution, std::string aFilepath)
-{
-    std::sort(aSolution.begin(), aSolution.end(), [](std::tuple<int, int, int> sol1, std::tuple<int, int, int> sol2)
-    {
-            if(std::get<1>(sol1) == std::get<1>(sol2))
-            {
-                return std::get<2>(sol1) < std::get<2>(sol2);
-            }
-            else
-            {
-                return std::get<1>(sol1) < std::get<1>(sol2);
-            };
+        SolveResult result;
+        if(context.mInstance)
+            result = solve(context, instances[i], instanceOptions);
+
+        std::ostringstream line;
+        line.precision(12);
+        line << "{\"instance\":" << jsonString(instances[i]) << ",\"solved\":" << (result.mSolved ? "true" : "false");
+        if(result.mSolved)
+            line << ",\"laxity\":" << llround(result.mLaxity) << ",\"gap\":" << jsonNumber(optimalityGap(*context.mInstance, result.mLaxity)) << ",\"solution\":" << jsonString(result.mSolutionPath);
+        line << ",\"seconds\":" << result.mSeconds << ",\"iterations\":" << result.mIterations << "}";
+        lines[i] = line.str();
+        solved[i] = result.mSolved;
     });
 
-    pugi::xml_document doc;
-
-    pugi::xml_node node = doc.append_child("solution");
-
-    for(auto& sol : aSolution)
+    int failed = 0;
+    for(unsigned i = 0; i < instances.size(); ++i)
     {
-        auto taskNode = node.append_child("Task");
-
-        taskNode.append_attribute("Id") = std::get<0>(sol);
-        taskNode.append_attribute("MCP") = std::get<1>(sol);
-        taskNode.append_attribute("Core") = std::get<2>(sol);
-        taskNode.append_attribute("WCRT") = round(tasks.at(std::get<0>(sol)).mWcet*platform.at(std::get<1>(sol)).mCores.at(std::get<2>(sol)).mWcetFactor);
+        summary << lines[i] << std::endl;
+        failed += !solved[i];
     }
-    
-
-    std::string laxity = "Total Laxity: " + std::to_string((int)round(calculateLaxity(aSolution)));
-
-    doc.insert_child_after(pugi::node_comment, node).set_value(laxity.c_str());
-
-    doc.print(std::cout);
 
-    std::string filename = "solution_" + aFilepath;
-    
-    doc.save_file(filename.c_str(), PUGIXML_TEXT("  "));
-
-    std::cout << filename << std::endl;
+    std::cout << "Batch: " << instances.size() - failed << " of " << instances.size() << " instances solved, summary in " << summaryPath << std::endl;
+    return failed ? -1 : 0;
 }
-
-int main()
-{
-    //add file path here
-    std::string filepath = "large.xml";
-    if(!readIn(filepath))
-        return -1;
-
-    std::vector<std::tuple<int, int, int>> initialSolution = createInitialSolution();
-    auto solution = runSimulatedAnnealing(initialSolution);
-
-    writeOutput(solution, filepath);
-
-    return 0;
-}
\ No newline at end of file
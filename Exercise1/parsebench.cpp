@@ -0,0 +1,95 @@
+#include "solver.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <stdio.h>
+#include <unistd.h>
+
+//parse time and memory of loadInstance on one Model file. Peak RSS covers the whole process, so make parsebench starts a
+//fresh process per file and build: the normal one reads the tasks in chunks on --threads threads and the rest in pugixml's
+//compact mode from a ParseArena, the PARSE_DOM one builds the whole DOM in compact mode from the arena and the
+//PARSE_BASELINE one builds the whole DOM in the default mode with malloc
+//
+//  ParseBench generated.xml [--repeat N] [--threads N]
+
+//resident set size of this process in MB
+double residentMegabytes()
+{
+    long pages = 0;
+    long resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if(statm)
+    {
+        if(fscanf(statm, "%ld %ld", &pages, &resident) != 2)
+            resident = 0;
+        fclose(statm);
+    }
+    return resident * (double)sysconf(_SC_PAGESIZE) / (1 << 20);
+}
+
+double peakResidentMegabytes()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+int main(int argc, char* argv[])
+{
+    int repeat = 3;
+    unsigned threads = 0;
+    bool usage = argc < 2;
+    for(int i = 2; i < argc && !usage; i += 2)
+    {
+        std::string option = argv[i];
+        if(i + 1 == argc)
+            usage = true;
+        else if(option == "--repeat")
+            repeat = std::max(1, std::stoi(argv[i + 1]));
+        else if(option == "--threads")
+            threads = std::stoul(argv[i + 1]);
+        else
+            usage = true;
+    }
+    if(usage)
+    {
+        std::cout << "Usage: ParseBench MODEL.xml [--repeat N] [--threads N]" << std::endl;
+        return -1;
+    }
+
+    double before = residentMegabytes();
+    std::ostream quiet(nullptr);
+    std::vector<double> seconds;
+    size_t taskCount = 0;
+    for(int i = 0; i < repeat; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<const ProblemInstance> instance = loadInstance(argv[1], quiet, threads);
+        seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        if(!instance)
+        {
+            std::cout << "Could not read " << argv[1] << std::endl;
+            return -1;
+        }
+        taskCount = instance->mTasks.size();
+    }
+    std::sort(seconds.begin(), seconds.end());
+
+#if defined(PARSE_BASELINE)
+    const char* build = "default+malloc";
+#elif defined(PARSE_DOM)
+    const char* build = "compact+arena";
+#else
+    const char* build = "chunked+arena";
+#endif
+    std::cout << std::left << std::setw(16) << build << std::right << std::fixed << std::setw(10) << taskCount << " tasks"
+              << std::setprecision(3) << std::setw(10) << seconds[seconds.size() / 2] << " s median parse"
+              << std::setprecision(1) << std::setw(10) << peakResidentMegabytes() - before << " MB peak RSS over the "
+              << before << " MB at start, " << residentMegabytes() << " MB after" << std::endl;
+    return 0;
+}
@@ -18,7 +18,10 @@
 // #define PUGIXML_WCHAR_MODE
 
 // Uncomment this to enable compact mode
-// #define PUGIXML_COMPACT
+// the solver parses in compact mode, make parsebench also builds with PARSE_BASELINE to compare against the default mode
+#ifndef PARSE_BASELINE
+#define PUGIXML_COMPACT
+#endif
 
 // Uncomment this to disable XPath
 // #define PUGIXML_NO_XPATH
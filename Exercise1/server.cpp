@@ -0,0 +1,282 @@
+#include "server.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//one request per line, any number of requests per connection, every connection is served on its own thread so solves run side by side
+//  load PATH                  -> loaded PATH TASKS CORES parsed|cached
+//  solve PATH [mode=M] [time-limit=S] [seed=N] [grasp=N] [polish] [warm-start=SOLUTION]
+//                             -> improved LAXITY SECONDS for every better laxity the search reports while it runs, then
+//                                done LAXITY GAP SECONDS ITERATIONS SOLUTION_FILE
+//                                every solve gets its own numbered solution file, solution_large.3.xml for the third solve
+//                                of the server, so solves of the same instance do not overwrite each other
+//  shutdown                   -> bye, and the server exits once the other connections are closed
+//a connection keeps the worker threads of its first solve that needs them for the solves after it, and parsed instances are
+//shared by all connections. Anything that fails is answered with error MESSAGE. By hand: socat - UNIX-CONNECT:/tmp/solver.sock
+
+//a parsed instance and the modification time of its file when it was parsed
+struct CachedInstance {
+    long long mModified;
+    std::shared_ptr<const ProblemInstance> mInstance;
+}typedef CachedInstance;
+
+//the parsed instances of all connections, a solve keeps its instance alive after a newer parse replaces it here
+struct InstanceCache {
+    std::mutex mMutex;
+    std::map<std::string, CachedInstance> mInstances;
+}typedef InstanceCache;
+
+//a client that went away mid-solve is not an error, the solve still finishes and its solution is written
+void sendLine(int aClient, const std::string& aLine)
+{
+    std::string line = aLine + "\n";
+    send(aClient, line.data(), line.size(), MSG_NOSIGNAL);
+}
+
+//read the next line from aClient into aLine, aBuffer keeps what was received past it, false once the client has closed
+bool readLine(int aClient, std::string& aBuffer, std::string& aLine)
+{
+    size_t end;
+    while((end = aBuffer.find('\n')) == std::string::npos)
+    {
+        char chunk[4096];
+        ssize_t received = recv(aClient, chunk, sizeof(chunk), 0);
+        if(received <= 0)
+            return false;
+        aBuffer.append(chunk, received);
+    }
+    aLine = aBuffer.substr(0, end);
+    aBuffer.erase(0, end + 1);
+    if(!aLine.empty() && aLine.back() == '\r')
+        aLine.pop_back();
+    return true;
+}
+
+//the instance at aPath, it is only parsed when it is not cached or its file changed since, nullptr if it cannot be read
+//the parse runs outside the lock, two connections asking for the same new file may both parse it
+std::shared_ptr<const ProblemInstance> useInstance(InstanceCache& aCache, const std::string& aPath, unsigned aThreadCount, bool& aCached)
+{
+    struct stat info;
+    if(stat(aPath.c_str(), &info) != 0)
+        return nullptr;
+    long long modified = info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+
+    {
+        std::lock_guard<std::mutex> lock(aCache.mMutex);
+        auto found = aCache.mInstances.find(aPath);
+        aCached = found != aCache.mInstances.end() && found->second.mModified == modified;
+        if(aCached)
+            return found->second.mInstance;
+    }
+
+    std::ostringstream log;
+    std::shared_ptr<const ProblemInstance> instance = loadInstance(aPath, log, aThreadCount);
+    if(!instance)
+        return nullptr;
+    std::lock_guard<std::mutex> lock(aCache.mMutex);
+    aCache.mInstances[aPath] = {modified, instance};
+    return instance;
+}
+
+//handle the requests of one client, returns false when it asked for a shutdown
+//aSolves counts the solve requests of all clients and numbers their solution files
+bool serveClient(int aClient, const SolveOptions& aDefaults, const SolverContext& aSettings, InstanceCache& aCache, std::atomic<unsigned long long>& aSolves)
+{
+    //the log of a solve is dropped, the client gets the progress as improved lines from the progress listener instead
+    std::ostream quiet(nullptr);
+    //worker threads kept for the whole connection, every solve of it runs on them instead of starting its own
+    std::shared_ptr<ThreadPool> pool;
+    std::string buffer;
+    std::string line;
+    while(readLine(aClient, buffer, line))
+    {
+        std::istringstream request(line);
+        std::string command;
+        std::string path;
+        request >> command >> path;
+
+        if(command == "shutdown")
+        {
+            sendLine(aClient, "bye");
+            return false;
+        }
+        if((command != "load" && command != "solve") || path.empty())
+        {
+            sendLine(aClient, "error expected load PATH, solve PATH [options] or shutdown");
+            continue;
+        }
+
+        SolveOptions options = aDefaults;
+        options.mWarmStart.clear();
+        options.mDelta.clear();
+        //requests may change the settings, every request starts from the ones the server was started with
+        SolverContext context = aSettings;
+        context.mLog = &quiet;
+        bool seeded = false;
+        bool valid = true;
+        try
+        {
+            std::string option;
+            while(valid && request >> option)
+            {
+                size_t equals = option.find('=');
+                std::string key = option.substr(0, equals);
+                std::string value = equals == std::string::npos ? "" : option.substr(equals + 1);
+                if(key == "mode")
+                    options.mMode = value;
+                else if(key == "time-limit")
+                    context.mTimeBudget = std::stod(value);
+                else if(key == "seed")
+                {
+                    context.mRng.seed(std::stoul(value));
+                    seeded = true;
+                }
+                else if(key == "grasp")
+                    options.mGraspCount = std::stoi(value);
+                else if(key == "polish")
+                    options.mPolish = true;
+                else if(key == "warm-start")
+                    options.mWarmStart = value;
+                else
+                {
+                    sendLine(aClient, "error unknown option " + option);
+                    valid = false;
+                }
+            }
+        }
+        catch(const std::exception&)
+        {
+            sendLine(aClient, "error bad value in " + line);
+            valid = false;
+        }
+        if(!valid)
+            continue;
+        if(command == "solve" && !isSolveMode(options.mMode))
+        {
+            sendLine(aClient, "error unknown mode " + options.mMode);
+            continue;
+        }
+        if(!options.mWarmStart.empty() && access(options.mWarmStart.c_str(), R_OK) != 0)
+        {
+            sendLine(aClient, "error could not read warm start " + options.mWarmStart);
+            continue;
+        }
+
+        if(!seeded)
+            context.mRng.seed(std::random_device{}());
+
+        bool cached;
+        context.mInstance = useInstance(aCache, path, context.mThreadCount, cached);
+        if(!context.mInstance)
+        {
+            sendLine(aClient, "error could not read " + path);
+            continue;
+        }
+        if(command == "load")
+        {
+            sendLine(aClient, "loaded " + path + " " + std::to_string(context.mInstance->mTasks.size()) + " " + std::to_string(context.mInstance->mCoreCount) + (cached ? " cached" : " parsed"));
+            continue;
+        }
+
+        options.mSolutionTag = std::to_string(++aSolves);
+        double best = -INFINITY;
+        context.mProgressListener = [aClient, &best, &context](const std::string&, double aLaxity) {
+            if(aLaxity <= best)
+                return;
+            best = aLaxity;
+            std::ostringstream improved;
+            improved << "improved " << llround(aLaxity) << " " << std::chrono::duration<double>(std::chrono::steady_clock::now() - context.mStart).count();
+            sendLine(aClient, improved.str());
+        };
+        context.mPool = pool;
+        SolveResult result = solve(context, path, options);
+        pool = context.mPool;
+
+        if(!result.mSolved)
+        {
+            sendLine(aClient, "error could not solve " + path);
+            continue;
+        }
+        std::ostringstream done;
+        done << "done " << llround(result.mLaxity) << " " << optimalityGap(*context.mInstance, result.mLaxity) << " " << result.mSeconds << " " << result.mIterations << " " << result.mSolutionPath;
+        sendLine(aClient, done.str());
+    }
+
+    return true;
+}
+
+int runServer(const std::string& aSocketPath, const SolveOptions& aDefaults, const SolverContext& aSettings)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if(aSocketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cout << "Socket path too long: " << aSocketPath << std::endl;
+        return -1;
+    }
+    strcpy(address.sun_path, aSocketPath.c_str());
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(aSocketPath.c_str());
+    if(server < 0 || bind(server, (sockaddr*)&address, sizeof(address)) != 0 || listen(server, 16) != 0)
+    {
+        std::cout << "Could not listen on " << aSocketPath << ": " << strerror(errno) << std::endl;
+        if(server >= 0)
+            close(server);
+        return -1;
+    }
+    std::cout << "Serving on " << aSocketPath << std::endl;
+
+    //a shutdown request stops the listener, which wakes the accept below, the connections still open are waited for
+    InstanceCache cache;
+    std::atomic<unsigned long long> solves(0);
+    std::atomic<bool> running(true);
+    std::mutex connectionMutex;
+    std::condition_variable connectionClosed;
+    int connections = 0;
+    while(running)
+    {
+        int client = accept(server, nullptr, nullptr);
+        if(client < 0)
+        {
+            if(running && (errno == EINTR || errno == ECONNABORTED))
+                continue;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(connectionMutex);
+            connections++;
+        }
+        std::thread([&, client]() {
+            if(!serveClient(client, aDefaults, aSettings, cache, solves))
+            {
+                running = false;
+                shutdown(server, SHUT_RDWR);
+            }
+            close(client);
+            std::lock_guard<std::mutex> lock(connectionMutex);
+            if(--connections == 0)
+                connectionClosed.notify_all();
+        }).detach();
+    }
+
+    std::unique_lock<std::mutex> lock(connectionMutex);
+    connectionClosed.wait(lock, [&connections]{ return connections == 0; });
+    close(server);
+    unlink(aSocketPath.c_str());
+    return 0;
+}
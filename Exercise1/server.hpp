@@ -0,0 +1,11 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include "taskalloc.hpp"
+
+#include <string>
+
+//answer solve requests on a unix domain socket until one asks for a shutdown, every request starts from aDefaults and a copy of aSettings
+int runServer(const std::string& aSocketPath, const SolveOptions& aDefaults, const SolverContext& aSettings);
+
+#endif
@@ -0,0 +1,2406 @@
+#include "solver.hpp"
+#include "threadpool.hpp"
+#include "telemetry.hpp"
+#include "instrumentation.hpp"
+#include "arena.hpp"
+#include "pugixml.hpp"
+
+#include <iostream>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+//slack allowed on a core's load so rounding does not reject a core that is exactly full
+const double loadTolerance = 1e-9;
+
+#ifndef PARSE_BASELINE
+//pugixml allocates from the ParseArena of the thread while one is alive, installed before main so no parse is running yet
+static const bool arenaInstalled = (pugi::set_memory_management_functions(ParseArena::allocateActive, ParseArena::deallocateActive), true);
+#endif
+
+#ifndef PARSE_BASELINE
+//the Application section is split into chunks of at least this many bytes, smaller files are read on the calling thread
+const size_t minimumChunkBytes = 1 << 20;
+
+bool isXmlSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+//attribute names the chunked reader accepts, pugixml also allows non-ASCII names, those take the pugixml path
+bool isNameStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+}
+
+bool isNameChar(char c)
+{
+    return isNameStart(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+//position of the Task attribute aName in the fields the chunked reader fills, -1 for any other attribute
+int taskField(const char* aName, const char* aNameEnd)
+{
+    static const char* const fields[] = {"Deadline", "Id", "Period", "WCET"};
+    for(int k = 0; k < 4; ++k)
+    {
+        if(strlen(fields[k]) == (size_t)(aNameEnd - aName) && memcmp(fields[k], aName, aNameEnd - aName) == 0)
+            return k;
+    }
+    return -1;
+}
+
+//an integer attribute value the way pugixml's as_int reads it, plain decimal values are converted here and anything else
+//(signs, hex, whitespace, values that could overflow) by pugixml itself through a scratch attribute
+int attributeInt(const char* aValue, const char* aValueEnd, pugi::xml_attribute& aScratch)
+{
+    if(aValueEnd > aValue && aValueEnd - aValue <= 9)
+    {
+        int value = 0;
+        const char* c = aValue;
+        while(c < aValueEnd && (unsigned)(*c - '0') < 10)
+            value = value * 10 + (*c++ - '0');
+        if(c == aValueEnd)
+            return value;
+    }
+    aScratch.set_value(std::string(aValue, aValueEnd).c_str());
+    return aScratch.as_int();
+}
+
+//read the Task elements that start in [aBegin, aEnd) into aTasks, reads stop at aLimit, the end of the Application content
+//only whitespace and Task elements without content are accepted, for anything else (comments, other elements, entities,
+//an element running past aEnd) this returns false and the caller parses the file with pugixml instead
+bool readTaskChunk(const char* aBegin, const char* aEnd, const char* aLimit, std::vector<Task>& aTasks)
+{
+    pugi::xml_document scratchDocument;
+    pugi::xml_attribute scratch = scratchDocument.append_child("Task").append_attribute("Value");
+    const char* c = aBegin;
+    while(true)
+    {
+        while(c < aEnd && isXmlSpace(*c))
+            ++c;
+        if(c >= aEnd)
+            return c == aEnd;
+        if(aLimit - c < 6 || memcmp(c, "<Task", 5) != 0 || !(isXmlSpace(c[5]) || c[5] == '/' || c[5] == '>'))
+            return false;
+        c += 5;
+
+        //the first of repeated attributes counts, as with pugixml's attribute()
+        const char* values[4] = {};
+        const char* valueEnds[4] = {};
+        while(true)
+        {
+            const char* separator = c;
+            while(c < aLimit && isXmlSpace(*c))
+                ++c;
+            if(c >= aLimit)
+                return false;
+            if(*c == '/' || *c == '>')
+                break;
+            if(c == separator || !isNameStart(*c))
+                return false;
+            const char* name = c;
+            while(c < aLimit && isNameChar(*c))
+                ++c;
+            const char* nameEnd = c;
+            while(c < aLimit && isXmlSpace(*c))
+                ++c;
+            if(c >= aLimit || *c != '=')
+                return false;
+            ++c;
+            while(c < aLimit && isXmlSpace(*c))
+                ++c;
+            if(c >= aLimit || (*c != '"' && *c != '\''))
+                return false;
+            char quote = *c++;
+            const char* value = c;
+            while(c < aLimit && *c != quote)
+            {
+                if(*c == '&' || *c == '<')
+                    return false;
+                ++c;
+            }
+            if(c >= aLimit)
+                return false;
+            int field = taskField(name, nameEnd);
+            if(field >= 0 && !values[field])
+            {
+                values[field] = value;
+                valueEnds[field] = c;
+            }
+            ++c;
+        }
+
+        if(*c == '/')
+        {
+            if(aLimit - c < 2 || c[1] != '>')
+                return false;
+            c += 2;
+        }
+        else
+        {
+            //<Task ...></Task> with nothing but whitespace in between
+            ++c;
+            while(c < aLimit && isXmlSpace(*c))
+                ++c;
+            if(aLimit - c < 6 || memcmp(c, "</Task", 6) != 0)
+                return false;
+            c += 6;
+            while(c < aLimit && isXmlSpace(*c))
+                ++c;
+            if(c >= aLimit || *c != '>')
+                return false;
+            ++c;
+        }
+
+        int fields[4];
+        for(int k = 0; k < 4; ++k)
+            fields[k] = values[k] ? attributeInt(values[k], valueEnds[k], scratch) : 0;
+        Task t;
+        t.mDeadline = fields[0];
+        t.mId = fields[1];
+        t.mPeriod = fields[2];
+        t.mWcet = fields[3];
+        t.mPriority = 1.0 / (double)t.mDeadline;
+        aTasks.push_back(t);
+    }
+}
+
+//fill aInstance's tasks from the file in aBuffer with the Application section split at <Task boundaries into one chunk per
+//thread, and parse what is left of the file into aDocument for the platform. Returns false with aInstance untouched if the
+//section is not made of plain Task elements or is not the one pugixml finds under Model
+bool readTasksChunked(const std::string& aBuffer, unsigned aThreadCount, ProblemInstance& aInstance, pugi::xml_document& aDocument)
+{
+    //comments, CDATA and DOCTYPE before the section could hide or fake the tags searched for here
+    size_t open = aBuffer.find("<Application");
+    if(open == std::string::npos || aBuffer.find("<!") < open)
+        return false;
+    size_t close = aBuffer.find('>', open);
+    if(close == std::string::npos || aBuffer[close - 1] == '/')
+        return false;
+    size_t contentStart = close + 1;
+    size_t contentEnd = aBuffer.find("</Application", contentStart);
+    if(contentEnd == std::string::npos)
+        return false;
+
+    std::string rest = aBuffer.substr(0, contentStart) + aBuffer.substr(contentEnd);
+    if(!aDocument.load_buffer(rest.data(), rest.size()) || aDocument.child("Model").child("Application").offset_debug() != (ptrdiff_t)open + 1)
+        return false;
+
+    const char* begin = aBuffer.data() + contentStart;
+    const char* end = aBuffer.data() + contentEnd;
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(aThreadCount, (end - begin) / minimumChunkBytes));
+    std::string_view content(begin, end - begin);
+    std::vector<const char*> bounds = {begin};
+    for(size_t k = 1; k < chunkCount; ++k)
+    {
+        size_t at = std::max<size_t>(content.size() * k / chunkCount, bounds.back() - begin);
+        while((at = content.find("<Task", at)) != std::string_view::npos && at + 5 < content.size() && !(isXmlSpace(content[at + 5]) || content[at + 5] == '/' || content[at + 5] == '>'))
+            at++;
+        bounds.push_back(at == std::string_view::npos ? end : std::min(begin + at, end));
+    }
+    bounds.push_back(end);
+
+    std::vector<std::vector<Task>> tables(chunkCount);
+    std::vector<char> valid(chunkCount, 0);
+    ThreadPool pool(chunkCount > 1 ? chunkCount : 0);
+    pool.parallelFor(chunkCount, [&](int k) {
+        tables[k].reserve((bounds[k + 1] - bounds[k]) / 48);
+        valid[k] = readTaskChunk(bounds[k], bounds[k + 1], end, tables[k]);
+    });
+    if(std::find(valid.begin(), valid.end(), 0) != valid.end())
+        return false;
+
+    //the chunks are in file order, so the tasks come out in the order pugixml gives them, which is ID order for generated files
+    size_t taskCount = 0;
+    for(auto& table : tables)
+        taskCount += table.size();
+    aInstance.mTasks.reserve(taskCount);
+    for(auto& table : tables)
+    {
+        for(auto& task : table)
+        {
+            aInstance.mTasks.push_back(task);
+            aInstance.mDeadlineSum += task.mDeadline;
+        }
+        std::vector<Task>().swap(table);
+    }
+    return true;
+}
+
+//the whole file in aBuffer, false if it cannot be read
+bool readFile(const std::string& aPath, std::string& aBuffer)
+{
+    FILE* file = fopen(aPath.c_str(), "rb");
+    if(!file)
+        return false;
+    bool read = fseek(file, 0, SEEK_END) == 0;
+    long size = read ? ftell(file) : -1;
+    read = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+    if(read)
+    {
+        aBuffer.resize(size);
+        read = fread(&aBuffer[0], 1, size, file) == (size_t)size;
+    }
+    fclose(file);
+    return read;
+}
+#endif
+
+//read in the html file and build the instance from it, the tasks are read on up to aThreadCount threads
+std::shared_ptr<const ProblemInstance> loadInstance(const std::string& aPath, std::ostream& aLog, unsigned aThreadCount)
+{
+    PROFILE_SCOPE(PhaseParse);
+    std::shared_ptr<ProblemInstance> instance = std::make_shared<ProblemInstance>();
+    {
+        //the DOM is only needed until the tables are filled, the arena frees all of it at the end of this block
+#ifndef PARSE_BASELINE
+        ParseArena arena;
+#endif
+        pugi::xml_document doc;
+
+        bool chunked = false;
+        //PARSE_DOM keeps compact mode and the arena but reads the tasks from the DOM, so make parsebench can measure both apart
+#if !defined(PARSE_BASELINE) && !defined(PARSE_DOM)
+        {
+            std::string buffer;
+            chunked = readFile(aPath, buffer) && readTasksChunked(buffer, aThreadCount ? aThreadCount : std::max(1u, std::thread::hardware_concurrency()), *instance, doc);
+        }
+#endif
+        if(!chunked && !doc.load_file(aPath.c_str()))
+        {
+            aLog << "Didn't find the specified file" << std::endl;
+            return nullptr;
+        }
+
+        //after a chunked read the Application element of doc is empty, this loop only reads the tasks on the pugixml path
+        for(pugi::xml_node readinTask : doc.child("Model").child("Application").children("Task"))
+        {
+            Task t;
+            t.mDeadline = readinTask.attribute("Deadline").as_int();
+            t.mId = readinTask.attribute("Id").as_int();
+            t.mPeriod = readinTask.attribute("Period").as_int();
+            t.mWcet = readinTask.attribute("WCET").as_int();
+            t.mPriority = 1.0 / (double)t.mDeadline;
+
+            instance->mTasks.push_back(t);
+
+            instance->mDeadlineSum += t.mDeadline;
+        }
+
+        for(pugi::xml_node readinMCP : doc.child("Model").child("Platform").children("MCP"))
+        {
+            MCP mcp;
+            mcp.mId = readinMCP.attribute("Id").as_int();
+            for(pugi::xml_node readinCore : readinMCP.children())
+            {
+                Core c;
+                c.mId = readinCore.attribute("Id").as_int();
+                c.mWcetFactor = readinCore.attribute("WCETFactor").as_double();
+                mcp.mCores.push_back(c);
+            }
+            instance->mPlatform.push_back(mcp);
+            addCores(*instance, instance->mPlatform.size() - 1);
+        }
+    }
+    aLog << "Read in success, " << instance->mCoreCount << " cores in " << instance->mClassCores.size() << " equivalence classes" << std::endl;
+    computeLaxityBounds(*instance, aLog);
+    return instance;
+}
+
+bool checkIfAllCoreHasTasks(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>> solution)
+{
+    PROFILE_SCOPE(PhaseFeasibility);
+    for(unsigned i = 0; i < aInstance.mPlatform.size(); ++i)
+    {
+        for(unsigned j = 0; j < aInstance.mPlatform.at(i).mCores.size(); ++j)
+        {
+            if(std::find_if(solution.begin(), solution.end(), [i, j](std::tuple<int, int, int> element){
+                return std::get<1>(element) == i && std::get<2>(element) == j;
+                }) == solution.end())
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//relative distance between a laxity and the tightest upper bound
+double optimalityGap(const ProblemInstance& aInstance, double aLaxity)
+{
+    return (aInstance.mLaxityBounds.mRelaxed - aLaxity) / fabs(aInstance.mLaxityBounds.mRelaxed);
+}
+
+bool withinTargetGap(SolverContext& aContext, double aLaxity)
+{
+    return aContext.mTargetGap > 0 && optimalityGap(*aContext.mInstance, aLaxity) <= aContext.mTargetGap;
+}
+
+double elapsedSeconds(SolverContext& aContext)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - aContext.mStart).count();
+}
+
+bool timeBudgetExpired(SolverContext& aContext)
+{
+    return aContext.mTimeBudget > 0 && elapsedSeconds(aContext) >= aContext.mTimeBudget;
+}
+
+//pass a laxity to the progress listener without printing it, the engines call this more often than they print
+void notifyProgress(SolverContext& aContext, const std::string& aStage, double aLaxity)
+{
+    if(aContext.mProgressListener)
+        aContext.mProgressListener(aStage, aLaxity);
+}
+
+void reportGap(SolverContext& aContext, const std::string& aStage, double aLaxity)
+{
+    notifyProgress(aContext, aStage, aLaxity);
+    *aContext.mLog << aStage << ": laxity " << (long long)round(aLaxity) << ", gap " << optimalityGap(*aContext.mInstance, aLaxity) * 100 << "%, " << elapsedSeconds(aContext) << " s" << std::endl;
+}
+
+//share of a core's time the task needs when it runs on the given core
+double taskLoad(const ProblemInstance& aInstance, int task, int mcp, int core)
+{
+    return aInstance.mTasks.at(task).mWcet * aInstance.mPlatform.at(mcp).mCores.at(core).mWcetFactor / aInstance.mTasks.at(task).mDeadline;
+}
+
+//See if the tasks on a core meet the deadline, under EDF this holds while the load of the core stays at most 1
+bool checkCoreDeadline(const ProblemInstance& aInstance, int i, int j, std::vector<std::tuple<int, int, int>> aSolution)
+{
+    PROFILE_SCOPE(PhaseFeasibility);
+    double load = 0;
+    for(auto& element : aSolution)
+    {
+        if(std::get<1>(element) == i && std::get<2>(element) == j)
+        {
+            load += taskLoad(aInstance, std::get<0>(element), i, j);
+        }
+    }
+
+    return load <= 1.0 + loadTolerance;
+}
+
+bool checkDeadline(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>> aSolution)
+{
+    PROFILE_SCOPE(PhaseFeasibility);
+    for(unsigned i = 0; i < aInstance.mPlatform.size(); ++i)
+    {
+        for(unsigned j = 0; j < aInstance.mPlatform.at(i).mCores.size(); ++j)
+        {
+            if(!checkCoreDeadline(aInstance, i, j, aSolution))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool check(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>> aSolution)
+{
+    PROFILE_SCOPE(PhaseFeasibility);
+    if(!checkIfAllCoreHasTasks(aInstance, aSolution))
+        return false;
+    if(!checkDeadline(aInstance, aSolution))
+        return false;
+    return true;
+}
+
+double coreFactor(const ProblemInstance& aInstance, int aFlatCore)
+{
+    return aInstance.mPlatform.at(aInstance.mFlatCores[aFlatCore].first).mCores.at(aInstance.mFlatCores[aFlatCore].second).mWcetFactor;
+}
+
+//give the cores of MCP aMcp their flat indices and sort them into the equivalence classes
+void addCores(ProblemInstance& aInstance, int aMcp)
+{
+    const MCP& mcp = aInstance.mPlatform[aMcp];
+    aInstance.mCoreOffset.push_back(aInstance.mCoreCount);
+    aInstance.mCoreCount += mcp.mCores.size();
+    for(unsigned j = 0; j < mcp.mCores.size(); ++j)
+    {
+        aInstance.mFlatCores.push_back(std::make_pair(aMcp, j));
+
+        unsigned k = 0;
+        while(k < aInstance.mClassCores.size() && coreFactor(aInstance, aInstance.mClassCores[k].front()) != mcp.mCores[j].mWcetFactor)
+            ++k;
+        if(k == aInstance.mClassCores.size())
+            aInstance.mClassCores.emplace_back();
+        aInstance.mClassCores[k].push_back(aInstance.mFlatCores.size() - 1);
+        aInstance.mCoreClass.push_back(k);
+    }
+}
+
+//build a solution constructively: one small task is reserved for every core, the rest are packed by decreasing utilization
+//onto the fastest core they fit on, ties between equally fast cores go to the fullest one. Returns an empty vector if some task fits nowhere
+//with aRandom given the construction is randomized for GRASP: the reserved tasks are drawn from the twice as many smallest ones
+//and every task goes to a random core of the restricted candidate list, the feasible cores within aAlpha of the best laxity gain
+std::vector<std::tuple<int, int, int>> createGreedySolution(const ProblemInstance& aInstance, std::mt19937* aRandom, double aAlpha)
+{
+    if(aInstance.mTasks.size() < (size_t)aInstance.mCoreCount)
+        return {};
+
+    std::vector<int> order(aInstance.mTasks.size());
+    for(unsigned i = 0; i < aInstance.mTasks.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&aInstance](int a, int b){
+        return aInstance.mTasks.at(a).mWcet / aInstance.mTasks.at(a).mDeadline > aInstance.mTasks.at(b).mWcet / aInstance.mTasks.at(b).mDeadline;
+    });
+
+    std::vector<int> cores(aInstance.mCoreCount);
+    for(int c = 0; c < aInstance.mCoreCount; ++c)
+        cores[c] = c;
+    std::stable_sort(cores.begin(), cores.end(), [&aInstance](int a, int b){ return coreFactor(aInstance, a) < coreFactor(aInstance, b); });
+
+    std::vector<std::tuple<int, int, int>> solution(aInstance.mTasks.size());
+    std::vector<double> loads(aInstance.mCoreCount, 0.0);
+    auto place = [&aInstance, &solution, &loads](int task, int core) {
+        solution[task] = std::make_tuple(task, aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second);
+        loads[core] += taskLoad(aInstance, task, aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second);
+    };
+
+    //the lowest utilization tasks hold the cores, the smallest WCET goes to the slowest core so little laxity is lost
+    if(aRandom)
+    {
+        int window = std::min<int>(order.size(), 2 * aInstance.mCoreCount);
+        std::shuffle(order.end() - window, order.end(), *aRandom);
+    }
+    std::vector<int> reserved(order.end() - aInstance.mCoreCount, order.end());
+    order.resize(order.size() - aInstance.mCoreCount);
+    std::sort(reserved.begin(), reserved.end(), [&aInstance](int a, int b){ return aInstance.mTasks.at(a).mWcet < aInstance.mTasks.at(b).mWcet; });
+    for(int k = 0; k < aInstance.mCoreCount; ++k)
+    {
+        int core = cores[aInstance.mCoreCount - 1 - k];
+        if(taskLoad(aInstance, reserved[k], aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second) > 1.0 + loadTolerance)
+            return {};
+        place(reserved[k], core);
+    }
+
+    std::vector<int> candidates;
+    for(int task : order)
+    {
+        int bestCore = -1;
+        if(aRandom)
+        {
+            //laxity gain on a core is -wcet * factor, so the candidate list is a factor range
+            candidates.clear();
+            for(int core : cores)
+            {
+                if(loads[core] + taskLoad(aInstance, task, aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second) <= 1.0 + loadTolerance)
+                    candidates.push_back(core);
+            }
+            if(candidates.empty())
+                return {};
+            double limit = coreFactor(aInstance, candidates.front()) + aAlpha * (coreFactor(aInstance, candidates.back()) - coreFactor(aInstance, candidates.front()));
+            while(coreFactor(aInstance, candidates.back()) > limit)
+                candidates.pop_back();
+            std::uniform_int_distribution<int> pick(0, candidates.size() - 1);
+            place(task, candidates[pick(*aRandom)]);
+            continue;
+        }
+
+        for(int core : cores)
+        {
+            if(bestCore >= 0 && coreFactor(aInstance, core) > coreFactor(aInstance, bestCore))
+                break;
+            double load = loads[core] + taskLoad(aInstance, task, aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second);
+            if(load <= 1.0 + loadTolerance && (bestCore < 0 || load > loads[bestCore] + taskLoad(aInstance, task, aInstance.mFlatCores[bestCore].first, aInstance.mFlatCores[bestCore].second)))
+                bestCore = core;
+        }
+        if(bestCore < 0)
+            return {};
+        place(task, bestCore);
+    }
+
+    return solution;
+}
+
+//compute both laxity bounds. In the relaxation a core with factor f offers 1 / f of utilization measured at factor 1 and
+//a unit of task t's utilization costs D_t * f there, so the optimal fractional fill puts the longest deadlines on the fastest cores
+void computeLaxityBounds(ProblemInstance& aInstance, std::ostream& aLog)
+{
+    std::vector<int> cores(aInstance.mCoreCount);
+    for(int c = 0; c < aInstance.mCoreCount; ++c)
+        cores[c] = c;
+    std::sort(cores.begin(), cores.end(), [&aInstance](int a, int b){ return coreFactor(aInstance, a) < coreFactor(aInstance, b); });
+
+    std::vector<int> order(aInstance.mTasks.size());
+    for(unsigned i = 0; i < aInstance.mTasks.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&aInstance](int a, int b){ return aInstance.mTasks.at(a).mDeadline > aInstance.mTasks.at(b).mDeadline; });
+
+    double trivialCost = 0;
+    double relaxedCost = 0;
+    unsigned core = 0;
+    double capacity = aInstance.mCoreCount > 0 ? 1.0 / coreFactor(aInstance, cores[0]) : 0;
+    for(int task : order)
+    {
+        trivialCost += aInstance.mTasks.at(task).mWcet * coreFactor(aInstance, cores[0]);
+        double utilization = aInstance.mTasks.at(task).mWcet / aInstance.mTasks.at(task).mDeadline;
+        while(utilization > 0 && core < cores.size())
+        {
+            double used = std::min(utilization, capacity);
+            relaxedCost += used * aInstance.mTasks.at(task).mDeadline * coreFactor(aInstance, cores[core]);
+            utilization -= used;
+            capacity -= used;
+            if(capacity <= 0 && ++core < cores.size())
+                capacity = 1.0 / coreFactor(aInstance, cores[core]);
+        }
+        //only reached when the platform is overloaded, the rest is charged at the slowest factor so the bound stays valid
+        if(utilization > 0)
+            relaxedCost += utilization * aInstance.mTasks.at(task).mDeadline * coreFactor(aInstance, cores.back());
+    }
+
+    aInstance.mLaxityBounds.mTrivial = aInstance.mDeadlineSum - trivialCost;
+    aInstance.mLaxityBounds.mRelaxed = aInstance.mDeadlineSum - relaxedCost;
+    aLog << "Laxity bounds: trivial " << (long long)floor(aInstance.mLaxityBounds.mTrivial) << ", capacity relaxation " << (long long)floor(aInstance.mLaxityBounds.mRelaxed) << std::endl;
+}
+
+//draw fully random assignments until one passes the check, gives up after aAttempts and returns an empty vector
+std::vector<std::tuple<int, int, int>> createRandomSolution(SolverContext& aContext, int aAttempts)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    std::vector<std::tuple<int, int, int>> solution;
+
+    std::uniform_int_distribution<std::mt19937::result_type> mcpRandom(0, instance.mPlatform.size()-1);
+    for(int attempt = 0; attempt < aAttempts; ++attempt)
+    {
+        solution.clear();
+        for(unsigned i = 0; i < instance.mTasks.size(); ++i)
+        {
+            int mcp = mcpRandom(aContext.mRng);
+            std::uniform_int_distribution<std::mt19937::result_type> coreRandom(0, instance.mPlatform.at(mcp).mCores.size() - 1);
+            int core = coreRandom(aContext.mRng);
+
+            solution.push_back(std::make_tuple(i, mcp, core));
+        }
+        if(check(instance, solution))
+            return solution;
+    }
+
+    return {};
+}
+
+//print why no feasible solution can exist, returns false if none of the necessary conditions is violated
+bool reportInfeasibility(const ProblemInstance& aInstance, std::ostream& aLog)
+{
+    if(aInstance.mTasks.size() < (size_t)aInstance.mCoreCount)
+    {
+        aLog << "Infeasible: " << aInstance.mTasks.size() << " tasks cannot occupy all " << aInstance.mCoreCount << " cores" << std::endl;
+        return true;
+    }
+
+    //a core with factor f has room for 1 / f of utilization measured at factor 1
+    double fastest = INFINITY;
+    double capacity = 0;
+    for(int c = 0; c < aInstance.mCoreCount; ++c)
+    {
+        fastest = std::min(fastest, coreFactor(aInstance, c));
+        capacity += 1.0 / coreFactor(aInstance, c);
+    }
+
+    double utilization = 0;
+    for(auto& task : aInstance.mTasks)
+    {
+        if(task.mWcet * fastest / task.mDeadline > 1.0 + loadTolerance)
+        {
+            aLog << "Infeasible: task " << task.mId << " misses its deadline even on the fastest core" << std::endl;
+            return true;
+        }
+        utilization += task.mWcet / task.mDeadline;
+    }
+
+    if(utilization > capacity + loadTolerance)
+    {
+        aLog << "Infeasible: total utilization " << utilization << " exceeds the platform capacity " << capacity << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+//create an initial solution, where in the vector the first is task id, second mcpid third coreid
+//returns an empty vector if no feasible solution was found
+std::vector<std::tuple<int, int, int>> createInitialSolution(SolverContext& aContext)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    PROFILE_SCOPE(PhaseConstruction);
+    std::vector<std::tuple<int, int, int>> solution = createGreedySolution(instance);
+    if(!solution.empty() && check(instance, solution))
+    {
+        *aContext.mLog << "Initial solution created" << std::endl;
+        return solution;
+    }
+
+    if(reportInfeasibility(instance, *aContext.mLog))
+        return {};
+
+    *aContext.mLog << "Greedy packing failed, falling back to random sampling" << std::endl;
+    solution = createRandomSolution(aContext, 100000);
+    if(solution.empty())
+    {
+        *aContext.mLog << "No feasible initial solution found" << std::endl;
+        return {};
+    }
+
+    *aContext.mLog << "Initial solution created" << std::endl;
+    return solution;
+}
+
+double calculateLaxity(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    PROFILE_SCOPE(PhaseCost);
+    double sum = 0;
+    for(auto& element : aSolution)
+    {
+        sum += aInstance.mPlatform.at(std::get<1>(element)).mCores.at(std::get<2>(element)).mWcetFactor * aInstance.mTasks.at(std::get<0>(element)).mWcet;
+    }
+
+    return aInstance.mDeadlineSum - sum;
+}
+
+//the solution as the flat core of every task id, with the cores of each class renumbered in order of first use
+//so assignments that only differ by a permutation of equivalent cores get the same key
+std::vector<int> canonicalAssignment(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    std::vector<int> assignment(aInstance.mTasks.size(), -1);
+    for(auto& element : aSolution)
+        assignment[std::get<0>(element)] = aInstance.mCoreOffset[std::get<1>(element)] + std::get<2>(element);
+
+    std::vector<int> relabel(aInstance.mCoreCount, -1);
+    std::vector<int> used(aInstance.mClassCores.size(), 0);
+    for(int& core : assignment)
+    {
+        if(relabel[core] < 0)
+            relabel[core] = aInstance.mClassCores[aInstance.mCoreClass[core]][used[aInstance.mCoreClass[core]]++];
+        core = relabel[core];
+    }
+
+    return assignment;
+}
+
+struct CanonicalHash {
+    size_t operator()(const std::vector<int>& aAssignment) const
+    {
+        size_t hash = aAssignment.size();
+        for(int core : aAssignment)
+            hash ^= core + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+//load of every core, indexed by the flat core index
+std::vector<double> calculateCoreLoads(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    PROFILE_SCOPE(PhaseFeasibility);
+    std::vector<double> loads(aInstance.mCoreCount, 0.0);
+    for(auto& element : aSolution)
+    {
+        loads[aInstance.mCoreOffset[std::get<1>(element)] + std::get<2>(element)] += taskLoad(aInstance, std::get<0>(element), std::get<1>(element), std::get<2>(element));
+    }
+
+    return loads;
+}
+
+//total load above capacity summed over the cores, zero when every deadline is met
+double calculateOverload(const std::vector<double>& loads)
+{
+    double overload = 0;
+    for(double load : loads)
+    {
+        if(load > 1.0 + loadTolerance)
+            overload += load - 1.0;
+    }
+
+    return overload;
+}
+
+int flatCoreOf(const ProblemInstance& aInstance, const std::tuple<int, int, int>& element)
+{
+    return aInstance.mCoreOffset[std::get<1>(element)] + std::get<2>(element);
+}
+
+CoreState buildCoreState(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    CoreState state;
+    state.mLoads = calculateCoreLoads(aInstance, aSolution);
+    state.mTaskCounts.assign(aInstance.mCoreCount, 0);
+    for(auto& element : aSolution)
+    {
+        state.mTaskCounts[flatCoreOf(aInstance, element)]++;
+    }
+
+    return state;
+}
+
+//change in laxity if the move was applied
+double moveLaxityDelta(const ProblemInstance& aInstance, const Move& aMove, const std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    PROFILE_SCOPE(PhaseCost);
+    const auto& first = aSolution[aMove.mFirst];
+    double firstWcet = aInstance.mTasks.at(std::get<0>(first)).mWcet;
+    double firstFactor = aInstance.mPlatform.at(std::get<1>(first)).mCores.at(std::get<2>(first)).mWcetFactor;
+    if(!aMove.mSwap)
+    {
+        return (firstFactor - aInstance.mPlatform.at(aMove.mMcp).mCores.at(aMove.mCore).mWcetFactor) * firstWcet;
+    }
+
+    const auto& second = aSolution[aMove.mSecond];
+    double secondWcet = aInstance.mTasks.at(std::get<0>(second)).mWcet;
+    double secondFactor = aInstance.mPlatform.at(std::get<1>(second)).mCores.at(std::get<2>(second)).mWcetFactor;
+    return (firstFactor - secondFactor) * (firstWcet - secondWcet);
+}
+
+//true if after the move every core still has a task and meets its deadlines
+bool moveIsFeasible(const ProblemInstance& aInstance, const Move& aMove, const std::vector<std::tuple<int, int, int>>& aSolution, const CoreState& aState)
+{
+    PROFILE_SCOPE(PhaseFeasibility);
+    const auto& first = aSolution[aMove.mFirst];
+    int from = flatCoreOf(aInstance, first);
+    if(!aMove.mSwap)
+    {
+        int to = aInstance.mCoreOffset[aMove.mMcp] + aMove.mCore;
+        if(from == to)
+            return false;
+        return aState.mTaskCounts[from] > 1 && aState.mLoads[to] + taskLoad(aInstance, std::get<0>(first), aMove.mMcp, aMove.mCore) <= 1.0 + loadTolerance;
+    }
+
+    const auto& second = aSolution[aMove.mSecond];
+    int to = flatCoreOf(aInstance, second);
+    if(from == to)
+        return false;
+    double fromLoad = aState.mLoads[from] - taskLoad(aInstance, std::get<0>(first), std::get<1>(first), std::get<2>(first)) + taskLoad(aInstance, std::get<0>(second), std::get<1>(first), std::get<2>(first));
+    double toLoad = aState.mLoads[to] - taskLoad(aInstance, std::get<0>(second), std::get<1>(second), std::get<2>(second)) + taskLoad(aInstance, std::get<0>(first), std::get<1>(second), std::get<2>(second));
+    return fromLoad <= 1.0 + loadTolerance && toLoad <= 1.0 + loadTolerance;
+}
+
+void applyMove(const ProblemInstance& aInstance, const Move& aMove, std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState)
+{
+    auto& first = aSolution[aMove.mFirst];
+    int from = flatCoreOf(aInstance, first);
+    if(!aMove.mSwap)
+    {
+        aState.mLoads[from] -= taskLoad(aInstance, std::get<0>(first), std::get<1>(first), std::get<2>(first));
+        aState.mTaskCounts[from]--;
+        std::get<1>(first) = aMove.mMcp;
+        std::get<2>(first) = aMove.mCore;
+        int to = flatCoreOf(aInstance, first);
+        aState.mLoads[to] += taskLoad(aInstance, std::get<0>(first), std::get<1>(first), std::get<2>(first));
+        aState.mTaskCounts[to]++;
+        return;
+    }
+
+    auto& second = aSolution[aMove.mSecond];
+    int to = flatCoreOf(aInstance, second);
+    aState.mLoads[from] += taskLoad(aInstance, std::get<0>(second), std::get<1>(first), std::get<2>(first)) - taskLoad(aInstance, std::get<0>(first), std::get<1>(first), std::get<2>(first));
+    aState.mLoads[to] += taskLoad(aInstance, std::get<0>(first), std::get<1>(second), std::get<2>(second)) - taskLoad(aInstance, std::get<0>(second), std::get<1>(second), std::get<2>(second));
+    std::swap(std::get<0>(first), std::get<0>(second));
+}
+
+//pick a random task and a different core to move it to
+Move randomRelocation(SolverContext& aContext, const std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    PROFILE_SCOPE(PhaseNeighbour);
+    std::uniform_int_distribution<int> generateTask(0, aSolution.size() - 1);
+    std::uniform_int_distribution<int> generateCore(0, instance.mCoreCount - 1);
+
+    Move move;
+    move.mSwap = false;
+    move.mFirst = generateTask(aContext.mRng);
+    move.mSecond = move.mFirst;
+    int from = flatCoreOf(instance, aSolution[move.mFirst]);
+    int core = generateCore(aContext.mRng);
+    //moving between equivalent cores does not change the laxity, so such targets are only used when there is no other class
+    if(instance.mClassCores.size() > 1)
+    {
+        while(instance.mCoreClass[core] == instance.mCoreClass[from])
+            core = generateCore(aContext.mRng);
+    }
+    else if(instance.mCoreCount > 1 && core == from)
+        core = (core + 1) % instance.mCoreCount;
+    move.mMcp = instance.mFlatCores[core].first;
+    move.mCore = instance.mFlatCores[core].second;
+    return move;
+}
+
+//pick two random tasks to exchange cores
+Move randomSwap(SolverContext& aContext, const std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    PROFILE_SCOPE(PhaseNeighbour);
+    std::uniform_int_distribution<int> generateTask(0, aSolution.size() - 1);
+
+    Move move;
+    move.mSwap = true;
+    move.mFirst = generateTask(aContext.mRng);
+    move.mSecond = generateTask(aContext.mRng);
+    for(int attempt = 0; attempt < 50 && instance.mCoreClass[flatCoreOf(instance, aSolution[move.mFirst])] == instance.mCoreClass[flatCoreOf(instance, aSolution[move.mSecond])]; ++attempt)
+        move.mSecond = generateTask(aContext.mRng);
+    move.mMcp = std::get<1>(aSolution[move.mSecond]);
+    move.mCore = std::get<2>(aSolution[move.mSecond]);
+    return move;
+}
+
+//the worker threads of the context, started by the first parallel engine of a solve and restarted if mThreadCount changed
+ThreadPool& contextPool(SolverContext& aContext)
+{
+    if(!aContext.mPool || aContext.mPool->threadCount() != aContext.mThreadCount)
+        aContext.mPool = std::make_shared<ThreadPool>(aContext.mThreadCount);
+    return *aContext.mPool;
+}
+
+//GRASP start: aCount randomized greedy constructions built in parallel, the aKeep feasible ones with the highest laxity are returned best first
+std::vector<std::vector<std::tuple<int, int, int>>> createGraspSolutions(SolverContext& aContext, int aCount, int aKeep)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    PROFILE_SCOPE(PhaseConstruction);
+    double alpha = 0.3;
+
+    //every construction gets its own generator, seeded here so the run only depends on the shared one
+    std::vector<std::mt19937::result_type> seeds(aCount);
+    for(auto& seed : seeds)
+        seed = aContext.mRng();
+
+    std::vector<std::vector<std::tuple<int, int, int>>> built(aCount);
+    std::vector<double> laxities(aCount, -INFINITY);
+    ThreadPool& pool = contextPool(aContext);
+    pool.parallelFor(aCount, [&](int i) {
+        std::mt19937 random(seeds[i]);
+        built[i] = createGreedySolution(instance, &random, alpha);
+        if(!built[i].empty() && check(instance, built[i]))
+            laxities[i] = calculateLaxity(instance, built[i]);
+    });
+
+    std::vector<int> order(aCount);
+    for(int i = 0; i < aCount; ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&laxities](int a, int b){ return laxities[a] > laxities[b]; });
+
+    std::vector<std::vector<std::tuple<int, int, int>>> best;
+    for(int i = 0; i < aCount && (int)best.size() < aKeep && laxities[order[i]] > -INFINITY; ++i)
+        best.push_back(built[order[i]]);
+
+    *aContext.mLog << "GRASP kept " << best.size() << " of " << aCount << " constructions" << std::endl;
+    return best;
+}
+
+//swap two tasks
+std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodSwap(SolverContext& aContext, std::vector<std::tuple<int, int, int>> solution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    std::uniform_int_distribution<std::mt19937::result_type> generate(0, solution.size() - 1);
+    unsigned i = generate(aContext.mRng);
+    unsigned j = generate(aContext.mRng);
+    //a swap between equivalent cores leaves the laxity unchanged
+    for(int counter = 0; counter < 50 && instance.mCoreClass[flatCoreOf(instance, solution[i])] == instance.mCoreClass[flatCoreOf(instance, solution[j])]; ++counter)
+        j = generate(aContext.mRng);
+
+    std::swap(std::get<0>(solution[i]), std::get<0>(solution[j]));
+    return solution;
+}
+
+//move a task from one core to an other, after 50 tries that find no move it swaps instead, aSwapped tells which it did
+std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodMove(SolverContext& aContext, std::vector<std::tuple<int, int, int>> solution, bool* aSwapped)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    int counter = 0;
+    std::uniform_int_distribution<std::mt19937::result_type> generate_mcp(0, instance.mPlatform.size() - 1);
+    std::uniform_int_distribution<std::mt19937::result_type> generate_task(0, instance.mTasks.size() - 1);
+
+    std::vector<std::tuple<int, int, int>> newSolution = solution;
+    do {
+        unsigned mcp = generate_mcp(aContext.mRng);
+        std::uniform_int_distribution<std::mt19937::result_type> generate_core(0, instance.mPlatform.at(mcp).mCores.size() - 1);
+        unsigned core = generate_core(aContext.mRng);
+        unsigned task = generate_task(aContext.mRng);
+
+        //a move to an equivalent core leaves the laxity unchanged
+        if (instance.mClassCores.size() > 1 && instance.mCoreClass[instance.mCoreOffset[mcp] + core] == instance.mCoreClass[flatCoreOf(instance, newSolution[task])])
+        {
+            counter++;
+            continue;
+        }
+
+        std::get<1>(newSolution[task]) = mcp;
+        std::get<2>(newSolution[task]) = core;
+        counter++;
+
+        if (checkIfAllCoreHasTasks(instance, newSolution))
+        {
+            if (aSwapped)
+                *aSwapped = false;
+            return newSolution;
+        }
+
+    } while (counter < 50);
+
+    if (aSwapped)
+        *aSwapped = true;
+    return selectRandomNeighbourhoodSwap(aContext, solution);
+}
+
+//a move for even aRandom and a swap for odd, aSwapped is set to whether the step taken was a swap
+std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodSolution(SolverContext& aContext, int random, std::vector<std::tuple<int, int, int>> solution, bool* aSwapped)
+{
+    PROFILE_SCOPE(PhaseNeighbour);
+    if (random % 2 == 0) 
+    {
+        return selectRandomNeighbourhoodMove(aContext, solution, aSwapped);
+    }
+    if (aSwapped)
+        *aSwapped = true;
+    return selectRandomNeighbourhoodSwap(aContext, solution);
+}
+
+bool calculateProbability(SolverContext& aContext, double delta, double temp)
+{
+    std::uniform_real_distribution<double> generate(0.0, 1.0);
+
+    double exponential = exp((-1 / temp) * delta);
+    double probability = generate(aContext.mRng);
+    return exponential >= probability;
+}
+
+
+std::vector<std::tuple<int, int, int>> runSimulatedAnnealing(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    double temp = aContext.mStartTemperature;
+    double alpha = 0.995;
+    int n = 0;
+    double delta = 0.0;
+    double solutionLaxity = 0.0;
+    double randomSolutionLaxity = 0.0;
+    std::vector<std::tuple<int, int, int>> solution = initialSolution;
+    //the chain can end below a state it passed, the best one is kept on the side
+    std::vector<std::tuple<int, int, int>> best = initialSolution;
+    double bestLaxity = calculateLaxity(instance, solution);
+    SA_TRACE(bool tracing = !aContext.mTracePath.empty();)
+    //the step the neighbourhood actually took, a move falls back to a swap, only asked for when tracing
+    bool* reportSwap = nullptr;
+    SA_TRACE(bool swapped = false;)
+    SA_TRACE(reportSwap = &swapped;)
+    SA_TRACE(aContext.mTraceRun++;)
+    SA_TRACE(if (tracing && !aContext.mTraceBuffer)
+        aContext.mTraceBuffer = std::make_shared<TraceBuffer>(1 << 16);)
+    while (temp > 1) 
+    {
+        // check deadlines are met
+        // if deadlines are not met, do not change temperature, generate new random solution
+        n++;
+        aContext.mIterations++;
+        std::vector<std::tuple<int, int, int>> randomSolution;
+        SA_TRACE(int spins = 0;)
+        do {
+            randomSolution = selectRandomNeighbourhoodSolution(aContext, n, solution, reportSwap);
+            SA_TRACE(spins++;)
+        } while (!checkDeadline(instance, randomSolution));
+
+        //if deadlines are met, run cost function to calculate laxity for both solutions
+        solutionLaxity = calculateLaxity(instance, solution);
+        randomSolutionLaxity = calculateLaxity(instance, randomSolution);
+
+        // calculate delta
+        delta = solutionLaxity - randomSolutionLaxity;
+
+        bool accepted = delta < 0 || calculateProbability(aContext, delta, temp);
+        if (accepted)
+        {
+            solution = randomSolution;
+            solutionLaxity = randomSolutionLaxity;
+            if (solutionLaxity > bestLaxity)
+            {
+                best = solution;
+                bestLaxity = solutionLaxity;
+            }
+        }
+        SA_TRACE(if (tracing && n % aContext.mTraceEvery == 0)
+            aContext.mTraceBuffer->record({n, temp, solutionLaxity, bestLaxity, spins, aContext.mTraceRun, (unsigned char)accepted, (unsigned char)swapped});)
+        temp *= alpha;
+
+        if (n % 1000 == 0)
+            reportGap(aContext, "Simulated annealing", solutionLaxity);
+        else if (n % 50 == 0)
+            notifyProgress(aContext, "Simulated annealing", solutionLaxity);
+        if (withinTargetGap(aContext, solutionLaxity) || timeBudgetExpired(aContext))
+            break;
+    }
+
+    SA_TRACE(if (tracing && aContext.mTraceBuffer->dropped() > 0)
+        *aContext.mLog << "Trace buffer full, the oldest " << aContext.mTraceBuffer->dropped() << " records were dropped, raise --trace-every to keep the whole run" << std::endl;)
+    SA_TRACE(if (tracing && !aContext.mTraceBuffer->flush(aContext.mTracePath, aContext.mTraceBinary, aContext.mTraceRun > 1))
+        *aContext.mLog << "Could not write the trace to " << aContext.mTracePath << std::endl;)
+    return best;
+}
+
+//simulated annealing that may walk through states that miss deadlines, the overload is penalised instead of rejected
+//steps are scored with moveLaxityDelta and the loads of the two cores they change, so an iteration does not rescan the solution
+std::vector<std::tuple<int, int, int>> runPenaltyAnnealing(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    double temp = aContext.mStartTemperature;
+    double alpha = 0.995;
+    int n = 0;
+    //laxity lost per unit of overload, starts at the average deadline, grows while the chain stays infeasible and shrinks
+    //back towards the start while it stays feasible, so the penalty stays a soft constraint
+    double startWeight = (double)instance.mDeadlineSum / instance.mTasks.size();
+    double penaltyWeight = startWeight;
+    double penaltyGrowth = 1.5;
+    int streakLimit = 20;
+    int infeasibleStreak = 0;
+    int feasibleStreak = 0;
+
+    std::vector<std::tuple<int, int, int>> solution = initialSolution;
+    CoreState state = buildCoreState(instance, solution);
+    double solutionLaxity = calculateLaxity(instance, solution);
+    int overloadedCores = 0;
+    for(double load : state.mLoads)
+        overloadedCores += load > 1.0 + loadTolerance;
+
+    //the chain itself may end infeasible, so the best solution meeting every deadline is kept on the side
+    std::vector<std::tuple<int, int, int>> bestFeasible = initialSolution;
+    double bestFeasibleLaxity = overloadedCores == 0 ? solutionLaxity : -INFINITY;
+
+    auto overloadOf = [](double aLoad) {
+        return aLoad > 1.0 + loadTolerance ? aLoad - 1.0 : 0.0;
+    };
+
+    while (temp > 1)
+    {
+        n++;
+        aContext.mIterations++;
+        Move move = n % 2 == 0 ? randomRelocation(aContext, solution) : randomSwap(aContext, solution);
+
+        //the loads of the two cores the step changes, a step that would leave a core without tasks is not taken
+        const auto& first = solution[move.mFirst];
+        int from = flatCoreOf(instance, first);
+        int to;
+        double fromLoad;
+        double toLoad;
+        if (!move.mSwap)
+        {
+            to = instance.mCoreOffset[move.mMcp] + move.mCore;
+            fromLoad = state.mLoads[from] - taskLoad(instance, std::get<0>(first), std::get<1>(first), std::get<2>(first));
+            toLoad = state.mLoads[to] + taskLoad(instance, std::get<0>(first), move.mMcp, move.mCore);
+        }
+        else
+        {
+            const auto& second = solution[move.mSecond];
+            to = flatCoreOf(instance, second);
+            fromLoad = state.mLoads[from] - taskLoad(instance, std::get<0>(first), std::get<1>(first), std::get<2>(first)) + taskLoad(instance, std::get<0>(second), std::get<1>(first), std::get<2>(first));
+            toLoad = state.mLoads[to] - taskLoad(instance, std::get<0>(second), std::get<1>(second), std::get<2>(second)) + taskLoad(instance, std::get<0>(first), std::get<1>(second), std::get<2>(second));
+        }
+
+        if (from != to && (move.mSwap || state.mTaskCounts[from] > 1))
+        {
+            double laxityDelta = moveLaxityDelta(instance, move, solution);
+            double overloadDelta = overloadOf(fromLoad) + overloadOf(toLoad) - overloadOf(state.mLoads[from]) - overloadOf(state.mLoads[to]);
+            double delta = penaltyWeight * overloadDelta - laxityDelta;
+
+            if (delta < 0 || calculateProbability(aContext, delta, temp))
+            {
+                overloadedCores += (fromLoad > 1.0 + loadTolerance) + (toLoad > 1.0 + loadTolerance)
+                                   - (state.mLoads[from] > 1.0 + loadTolerance) - (state.mLoads[to] > 1.0 + loadTolerance);
+                applyMove(instance, move, solution, state);
+                solutionLaxity += laxityDelta;
+            }
+        }
+
+        if (overloadedCores == 0)
+        {
+            infeasibleStreak = 0;
+            if (solutionLaxity > bestFeasibleLaxity)
+            {
+                bestFeasible = solution;
+                bestFeasibleLaxity = solutionLaxity;
+            }
+            if (++feasibleStreak >= streakLimit)
+            {
+                penaltyWeight = std::max(startWeight, penaltyWeight / penaltyGrowth);
+                feasibleStreak = 0;
+            }
+        }
+        else
+        {
+            feasibleStreak = 0;
+            if (++infeasibleStreak >= streakLimit)
+            {
+                penaltyWeight *= penaltyGrowth;
+                infeasibleStreak = 0;
+            }
+        }
+
+        temp *= alpha;
+
+        if (n % 1000 == 0)
+            reportGap(aContext, "Penalty annealing", bestFeasibleLaxity);
+        else if (n % 50 == 0)
+            notifyProgress(aContext, "Penalty annealing", bestFeasibleLaxity);
+        if (withinTargetGap(aContext, bestFeasibleLaxity) || timeBudgetExpired(aContext))
+            break;
+    }
+
+    *aContext.mLog << "Final penalty weight: " << penaltyWeight << std::endl;
+    return bestFeasible;
+}
+
+//tabu search over sampled candidate lists of moves and swaps, scored by delta evaluation
+std::vector<std::tuple<int, int, int>> runTabuSearch(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    int maxIterations = 2000;
+    int candidateCount = 60;
+    //iterations a task is kept from returning to the core it just left
+    int tabuTenure = 5 + (int)sqrt(instance.mTasks.size());
+
+    //non-improving moves into often used (task, core) pairs are penalised, scaled to a typical move delta
+    double frequencyWeight = 0;
+    for(auto& task : instance.mTasks)
+        frequencyWeight += task.mWcet;
+    frequencyWeight /= instance.mTasks.size();
+
+    std::vector<std::tuple<int, int, int>> solution = initialSolution;
+    CoreState state = buildCoreState(instance, solution);
+    double solutionLaxity = calculateLaxity(instance, solution);
+
+    std::vector<std::tuple<int, int, int>> best = solution;
+    double bestLaxity = solutionLaxity;
+
+    //both indexed by task id * coreCount + flat core index
+    std::vector<int> tabuUntil(instance.mTasks.size() * instance.mCoreCount, 0);
+    std::vector<int> frequency(instance.mTasks.size() * instance.mCoreCount, 0);
+
+    //the pairs a move creates, the task of the first entry ends up on the second's core and the other way round for swaps
+    auto targetPairs = [&instance, &solution](const Move& move, int pairs[2]) {
+        const auto& first = solution[move.mFirst];
+        if(!move.mSwap)
+        {
+            pairs[0] = std::get<0>(first) * instance.mCoreCount + instance.mCoreOffset[move.mMcp] + move.mCore;
+            return 1;
+        }
+        const auto& second = solution[move.mSecond];
+        pairs[0] = std::get<0>(first) * instance.mCoreCount + flatCoreOf(instance, second);
+        pairs[1] = std::get<0>(second) * instance.mCoreCount + flatCoreOf(instance, first);
+        return 2;
+    };
+
+    long long evaluations = 0;
+    for(int iteration = 1; iteration <= maxIterations; ++iteration)
+    {
+        aContext.mIterations++;
+        bool found = false;
+        Move bestMove;
+        double bestMoveDelta = 0;
+        double bestScore = -INFINITY;
+
+        for(int k = 0; k < candidateCount; ++k)
+        {
+            Move move = k % 2 == 0 ? randomRelocation(aContext, solution) : randomSwap(aContext, solution);
+            evaluations++;
+            if(!moveIsFeasible(instance, move, solution, state))
+                continue;
+
+            double delta = moveLaxityDelta(instance, move, solution);
+            int pairs[2];
+            int pairCount = targetPairs(move, pairs);
+            bool tabu = false;
+            int pairFrequency = 0;
+            for(int p = 0; p < pairCount; ++p)
+            {
+                tabu = tabu || tabuUntil[pairs[p]] > iteration;
+                pairFrequency += frequency[pairs[p]];
+            }
+
+            //aspiration: a tabu move is still allowed when it beats the best laxity found so far
+            if(tabu && solutionLaxity + delta <= bestLaxity)
+                continue;
+
+            double score = delta;
+            if(delta <= 0)
+                score -= frequencyWeight * pairFrequency / iteration;
+
+            if(score > bestScore)
+            {
+                found = true;
+                bestScore = score;
+                bestMove = move;
+                bestMoveDelta = delta;
+            }
+        }
+
+        if(!found)
+            continue;
+
+        //forbid the moved tasks from going back to the cores they leave
+        const auto& first = solution[bestMove.mFirst];
+        tabuUntil[std::get<0>(first) * instance.mCoreCount + flatCoreOf(instance, first)] = iteration + tabuTenure;
+        if(bestMove.mSwap)
+        {
+            const auto& second = solution[bestMove.mSecond];
+            tabuUntil[std::get<0>(second) * instance.mCoreCount + flatCoreOf(instance, second)] = iteration + tabuTenure;
+        }
+        int pairs[2];
+        int pairCount = targetPairs(bestMove, pairs);
+        for(int p = 0; p < pairCount; ++p)
+            frequency[pairs[p]]++;
+
+        applyMove(instance, bestMove, solution, state);
+        solutionLaxity += bestMoveDelta;
+
+        if(solutionLaxity > bestLaxity)
+        {
+            best = solution;
+            bestLaxity = solutionLaxity;
+            notifyProgress(aContext, "Tabu search", bestLaxity);
+        }
+
+        if(iteration % 500 == 0)
+            reportGap(aContext, "Tabu search", bestLaxity);
+        if(withinTargetGap(aContext, bestLaxity) || timeBudgetExpired(aContext))
+            break;
+    }
+
+    *aContext.mLog << "Tabu search evaluated " << evaluations << " candidates" << std::endl;
+    return best;
+}
+
+//move tasks off overloaded cores and onto empty ones, always taking the move that loses the least laxity
+//returns false if some core could not be fixed
+bool repairSolution(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>>& aSolution)
+{
+    CoreState state = buildCoreState(aInstance, aSolution);
+    return repairSolution(aInstance, aSolution, state);
+}
+
+//the same on a core state that is already up to date, only the overloaded and empty cores are looked at
+bool repairSolution(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState)
+{
+    for(int from = 0; from < aInstance.mCoreCount; ++from)
+    {
+        while(aState.mLoads[from] > 1.0 + loadTolerance)
+        {
+            bool found = false;
+            Move bestMove;
+            double bestDelta = -INFINITY;
+            for(unsigned e = 0; e < aSolution.size(); ++e)
+            {
+                if(flatCoreOf(aInstance, aSolution[e]) != from)
+                    continue;
+                for(int to = 0; to < aInstance.mCoreCount; ++to)
+                {
+                    int task = std::get<0>(aSolution[e]);
+                    if(to == from || aState.mLoads[to] + taskLoad(aInstance, task, aInstance.mFlatCores[to].first, aInstance.mFlatCores[to].second) > 1.0 + loadTolerance)
+                        continue;
+                    Move move = {false, e, e, aInstance.mFlatCores[to].first, aInstance.mFlatCores[to].second};
+                    double delta = moveLaxityDelta(aInstance, move, aSolution);
+                    if(delta > bestDelta)
+                    {
+                        found = true;
+                        bestDelta = delta;
+                        bestMove = move;
+                    }
+                }
+            }
+            if(!found)
+                return false;
+            applyMove(aInstance, bestMove, aSolution, aState);
+        }
+    }
+
+    for(int to = 0; to < aInstance.mCoreCount; ++to)
+    {
+        if(aState.mTaskCounts[to] > 0)
+            continue;
+
+        bool found = false;
+        Move bestMove;
+        double bestDelta = -INFINITY;
+        for(unsigned e = 0; e < aSolution.size(); ++e)
+        {
+            Move move = {false, e, e, aInstance.mFlatCores[to].first, aInstance.mFlatCores[to].second};
+            if(!moveIsFeasible(aInstance, move, aSolution, aState))
+                continue;
+            double delta = moveLaxityDelta(aInstance, move, aSolution);
+            if(delta > bestDelta)
+            {
+                found = true;
+                bestDelta = delta;
+                bestMove = move;
+            }
+        }
+        if(!found)
+            return false;
+        applyMove(aInstance, bestMove, aSolution, aState);
+    }
+
+    return true;
+}
+
+//child takes every task's core from either parent with equal chance, both parents have entry i holding task i
+std::vector<std::tuple<int, int, int>> uniformCrossover(SolverContext& aContext, const std::vector<std::tuple<int, int, int>>& aFirst, const std::vector<std::tuple<int, int, int>>& aSecond)
+{
+    std::bernoulli_distribution coin(0.5);
+    std::vector<std::tuple<int, int, int>> child = aFirst;
+    for(unsigned i = 0; i < child.size(); ++i)
+    {
+        if(coin(aContext.mRng))
+            child[i] = aSecond[i];
+    }
+
+    return child;
+}
+
+//child keeps the complete task sets of a random half of the first parent's cores, the other tasks come from the second parent
+std::vector<std::tuple<int, int, int>> corePreservingCrossover(SolverContext& aContext, const std::vector<std::tuple<int, int, int>>& aFirst, const std::vector<std::tuple<int, int, int>>& aSecond)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    std::bernoulli_distribution coin(0.5);
+    std::vector<bool> keepCore(instance.mCoreCount);
+    for(int c = 0; c < instance.mCoreCount; ++c)
+        keepCore[c] = coin(aContext.mRng);
+
+    std::vector<std::tuple<int, int, int>> child = aSecond;
+    for(unsigned i = 0; i < child.size(); ++i)
+    {
+        if(keepCore[flatCoreOf(instance, aFirst[i])])
+            child[i] = aFirst[i];
+    }
+
+    return child;
+}
+
+//generational genetic algorithm, children are built and repaired on this thread and their fitness is evaluated on a thread pool
+std::vector<std::tuple<int, int, int>> runGeneticAlgorithm(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    int populationSize = 40;
+    int generations = 300;
+    int eliteCount = 2;
+    int tournamentSize = 3;
+    double mutationRate = 0.3;
+
+    ThreadPool& pool = contextPool(aContext);
+    auto start = std::chrono::steady_clock::now();
+    long long evaluations = 0;
+
+    std::vector<std::vector<std::tuple<int, int, int>>> population(populationSize, initialSolution);
+    std::vector<double> fitness(populationSize);
+
+    //the population starts as scrambled and repaired copies of the initial solution
+    for(int i = 1; i < populationSize; ++i)
+    {
+        CoreState state = buildCoreState(instance, population[i]);
+        for(unsigned k = 0; k < instance.mTasks.size() / 4 + 1; ++k)
+            applyMove(instance, randomRelocation(aContext, population[i]), population[i], state);
+        if(!repairSolution(instance, population[i]))
+            population[i] = initialSolution;
+    }
+
+    //fitness of every assignment seen so far, keyed canonically so children that only permute equivalent cores are not evaluated again
+    std::unordered_map<std::vector<int>, double, CanonicalHash> fitnessCache;
+    std::vector<std::vector<int>> keys(populationSize);
+    std::vector<int> pending;
+    auto evaluate = [&]() {
+        pending.clear();
+        for(int i = 0; i < populationSize; ++i)
+        {
+            keys[i] = canonicalAssignment(instance, population[i]);
+            auto cached = fitnessCache.find(keys[i]);
+            if(cached != fitnessCache.end())
+                fitness[i] = cached->second;
+            else
+                pending.push_back(i);
+        }
+        pool.parallelFor(pending.size(), [&](int k) {
+            int i = pending[k];
+            fitness[i] = check(instance, population[i]) ? calculateLaxity(instance, population[i]) : -INFINITY;
+        });
+        for(int i : pending)
+            fitnessCache[keys[i]] = fitness[i];
+        evaluations += pending.size();
+    };
+    evaluate();
+
+    std::uniform_int_distribution<int> generateIndividual(0, populationSize - 1);
+    std::bernoulli_distribution coin(0.5);
+    std::bernoulli_distribution mutate(mutationRate);
+    auto tournament = [&]() {
+        int winner = generateIndividual(aContext.mRng);
+        for(int k = 1; k < tournamentSize; ++k)
+        {
+            int other = generateIndividual(aContext.mRng);
+            if(fitness[other] > fitness[winner])
+                winner = other;
+        }
+        return winner;
+    };
+
+    for(int generation = 0; generation < generations; ++generation)
+    {
+        aContext.mIterations++;
+        std::vector<int> order(populationSize);
+        for(int i = 0; i < populationSize; ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&fitness](int a, int b){ return fitness[a] > fitness[b]; });
+
+        std::vector<std::vector<std::tuple<int, int, int>>> next;
+        next.reserve(populationSize);
+        for(int i = 0; i < eliteCount; ++i)
+            next.push_back(population[order[i]]);
+
+        while((int)next.size() < populationSize)
+        {
+            const auto& first = population[tournament()];
+            const auto& second = population[tournament()];
+            std::vector<std::tuple<int, int, int>> child = coin(aContext.mRng) ? uniformCrossover(aContext, first, second) : corePreservingCrossover(aContext, first, second);
+            if(mutate(aContext.mRng))
+            {
+                CoreState state = buildCoreState(instance, child);
+                applyMove(instance, randomRelocation(aContext, child), child, state);
+            }
+            if(!repairSolution(instance, child))
+                child = first;
+            next.push_back(child);
+        }
+
+        population.swap(next);
+        evaluate();
+
+        double bestFitness = *std::max_element(fitness.begin(), fitness.end());
+        if((generation + 1) % 50 == 0)
+            reportGap(aContext, "Genetic algorithm", bestFitness);
+        else
+            notifyProgress(aContext, "Genetic algorithm", bestFitness);
+        if(withinTargetGap(aContext, bestFitness) || timeBudgetExpired(aContext))
+            break;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    *aContext.mLog << "Genetic algorithm: " << evaluations << " evaluations in " << seconds << " s, " << evaluations / seconds << " evaluations/s on " << aContext.mThreadCount << " threads" << std::endl;
+
+    int best = std::max_element(fitness.begin(), fitness.end()) - fitness.begin();
+    return population[best];
+}
+
+//take a structured set of tasks off their cores: everything on two cores, one period class or a random 10%
+//the entries keep their old core in the solution, only the core state forgets them
+std::vector<unsigned> ruinSolution(SolverContext& aContext, const std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    std::uniform_int_distribution<int> generateStrategy(0, 2);
+    std::uniform_int_distribution<int> generateCore(0, instance.mCoreCount - 1);
+    std::uniform_int_distribution<int> generateEntry(0, aSolution.size() - 1);
+    std::bernoulli_distribution tenPercent(0.1);
+
+    int strategy = generateStrategy(aContext.mRng);
+    int firstCore = generateCore(aContext.mRng);
+    int secondCore = generateCore(aContext.mRng);
+    int period = instance.mTasks.at(std::get<0>(aSolution[generateEntry(aContext.mRng)])).mPeriod;
+
+    std::vector<unsigned> removed;
+    for(unsigned e = 0; e < aSolution.size(); ++e)
+    {
+        bool remove;
+        if(strategy == 0)
+            remove = flatCoreOf(instance, aSolution[e]) == firstCore || flatCoreOf(instance, aSolution[e]) == secondCore;
+        else if(strategy == 1)
+            remove = instance.mTasks.at(std::get<0>(aSolution[e])).mPeriod == period;
+        else
+            remove = tenPercent(aContext.mRng);
+
+        if(remove)
+        {
+            removed.push_back(e);
+            aState.mLoads[flatCoreOf(instance, aSolution[e])] -= taskLoad(instance, std::get<0>(aSolution[e]), std::get<1>(aSolution[e]), std::get<2>(aSolution[e]));
+            aState.mTaskCounts[flatCoreOf(instance, aSolution[e])]--;
+        }
+    }
+
+    return removed;
+}
+
+//put the removed entries back, first one into every empty core, then the rest on the feasible core that gives the most laxity
+//returns false if some task or empty core cannot be filled within its capacity
+bool recreateSolution(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState, std::vector<unsigned> aRemoved)
+{
+    auto place = [&aInstance, &aSolution, &aState](unsigned e, int core) {
+        std::get<1>(aSolution[e]) = aInstance.mFlatCores[core].first;
+        std::get<2>(aSolution[e]) = aInstance.mFlatCores[core].second;
+        aState.mLoads[core] += taskLoad(aInstance, std::get<0>(aSolution[e]), aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second);
+        aState.mTaskCounts[core]++;
+    };
+
+    //the smallest tasks give up the least laxity when they have to sit on an empty slow core
+    std::sort(aRemoved.begin(), aRemoved.end(), [&aInstance, &aSolution](unsigned a, unsigned b){
+        return aInstance.mTasks.at(std::get<0>(aSolution[a])).mWcet < aInstance.mTasks.at(std::get<0>(aSolution[b])).mWcet;
+    });
+    //slowest empty cores first, they have the fewest tasks that fit
+    std::vector<int> emptyCores;
+    for(int core = 0; core < aInstance.mCoreCount; ++core)
+    {
+        if(aState.mTaskCounts[core] == 0)
+            emptyCores.push_back(core);
+    }
+    std::stable_sort(emptyCores.begin(), emptyCores.end(), [&aInstance](int a, int b){
+        return coreFactor(aInstance, a) > coreFactor(aInstance, b);
+    });
+    for(int core : emptyCores)
+    {
+        //the smallest task that fits, a slow core may not take a task at all
+        auto fits = std::find_if(aRemoved.begin(), aRemoved.end(), [&aInstance, &aSolution, &aState, core](unsigned e){
+            return aState.mLoads[core] + taskLoad(aInstance, std::get<0>(aSolution[e]), aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second) <= 1.0 + loadTolerance;
+        });
+        if(fits == aRemoved.end())
+            return false;
+        place(*fits, core);
+        aRemoved.erase(fits);
+    }
+
+    //largest tasks first, they gain the most from a fast core
+    for(auto it = aRemoved.rbegin(); it != aRemoved.rend(); ++it)
+    {
+        int task = std::get<0>(aSolution[*it]);
+        int bestCore = -1;
+        for(int core = 0; core < aInstance.mCoreCount; ++core)
+        {
+            if(aState.mLoads[core] + taskLoad(aInstance, task, aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second) > 1.0 + loadTolerance)
+                continue;
+            if(bestCore < 0 || aInstance.mPlatform.at(aInstance.mFlatCores[core].first).mCores.at(aInstance.mFlatCores[core].second).mWcetFactor < aInstance.mPlatform.at(aInstance.mFlatCores[bestCore].first).mCores.at(aInstance.mFlatCores[bestCore].second).mWcetFactor)
+                bestCore = core;
+        }
+        if(bestCore < 0)
+            return false;
+        place(*it, bestCore);
+    }
+
+    return true;
+}
+
+//large neighbourhood search, every step ruins part of the solution and greedily rebuilds it, steps are accepted like in annealing
+std::vector<std::tuple<int, int, int>> runLargeNeighbourhoodSearch(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    int iterations = 1000;
+    //start around the laxity a single task swing is worth and cool down to 1 over the run
+    double temp = 0;
+    for(auto& task : instance.mTasks)
+        temp += task.mWcet;
+    temp /= instance.mTasks.size();
+    double alpha = pow(1.0 / temp, 1.0 / iterations);
+
+    std::vector<std::tuple<int, int, int>> solution = initialSolution;
+    CoreState state = buildCoreState(instance, solution);
+    double solutionLaxity = calculateLaxity(instance, solution);
+
+    std::vector<std::tuple<int, int, int>> best = solution;
+    double bestLaxity = solutionLaxity;
+
+    for(int n = 0; n < iterations; ++n)
+    {
+        aContext.mIterations++;
+        std::vector<std::tuple<int, int, int>> candidate = solution;
+        CoreState candidateState = state;
+        std::vector<unsigned> removed = ruinSolution(aContext, candidate, candidateState);
+        if(recreateSolution(instance, candidate, candidateState, removed))
+        {
+            double candidateLaxity = calculateLaxity(instance, candidate);
+            double delta = solutionLaxity - candidateLaxity;
+            if(delta < 0 || calculateProbability(aContext, delta, temp))
+            {
+                solution.swap(candidate);
+                state = candidateState;
+                solutionLaxity = candidateLaxity;
+                if(solutionLaxity > bestLaxity)
+                {
+                    best = solution;
+                    bestLaxity = solutionLaxity;
+                    notifyProgress(aContext, "Large neighbourhood search", bestLaxity);
+                }
+            }
+        }
+        temp *= alpha;
+
+        if((n + 1) % 100 == 0)
+            reportGap(aContext, "Large neighbourhood search", bestLaxity);
+        if(withinTargetGap(aContext, bestLaxity) || timeBudgetExpired(aContext))
+            break;
+    }
+
+    return best;
+}
+
+//best-improvement local search over every move and swap until no step raises the laxity
+//the scan is split across the thread pool by the first entry of the step, with aFocus only steps moving those entries are scanned
+std::vector<std::tuple<int, int, int>> polishSolution(SolverContext& aContext, std::vector<std::tuple<int, int, int>> aSolution, const std::vector<unsigned>& aFocus)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    PROFILE_SCOPE(PhaseSearch);
+    ThreadPool& pool = contextPool(aContext);
+    CoreState state = buildCoreState(instance, aSolution);
+    double startLaxity = calculateLaxity(instance, aSolution);
+    int steps = 0;
+
+    //without a focus every swap is found from its lower entry, with one a focused entry may swap with any other
+    std::vector<unsigned> entries = aFocus;
+    if(entries.empty())
+    {
+        entries.resize(aSolution.size());
+        for(unsigned e = 0; e < aSolution.size(); ++e)
+            entries[e] = e;
+    }
+    bool focused = !aFocus.empty();
+
+    std::vector<Move> bestMoves(entries.size());
+    std::vector<double> bestDeltas(entries.size());
+    auto scanEntry = [&instance, &aSolution, &state, &bestMoves, &bestDeltas, &entries, focused](int k) {
+        unsigned e = entries[k];
+        bestDeltas[k] = 0;
+        for(int core = 0; core < instance.mCoreCount; ++core)
+        {
+            Move move = {false, e, e, instance.mFlatCores[core].first, instance.mFlatCores[core].second};
+            double delta = moveLaxityDelta(instance, move, aSolution);
+            if(delta > bestDeltas[k] && moveIsFeasible(instance, move, aSolution, state))
+            {
+                bestDeltas[k] = delta;
+                bestMoves[k] = move;
+            }
+        }
+        for(unsigned other = focused ? 0 : e + 1; other < aSolution.size(); ++other)
+        {
+            if(other == e)
+                continue;
+            Move move = {true, e, other, std::get<1>(aSolution[other]), std::get<2>(aSolution[other])};
+            double delta = moveLaxityDelta(instance, move, aSolution);
+            if(delta > bestDeltas[k] && moveIsFeasible(instance, move, aSolution, state))
+            {
+                bestDeltas[k] = delta;
+                bestMoves[k] = move;
+            }
+        }
+    };
+
+    while(true)
+    {
+        pool.parallelFor(entries.size(), scanEntry);
+        int best = std::max_element(bestDeltas.begin(), bestDeltas.end()) - bestDeltas.begin();
+        if(bestDeltas[best] <= loadTolerance)
+            break;
+        applyMove(instance, bestMoves[best], aSolution, state);
+        steps++;
+        aContext.mIterations++;
+        if(timeBudgetExpired(aContext))
+            break;
+    }
+
+    *aContext.mLog << "Polishing gained " << calculateLaxity(instance, aSolution) - startLaxity << " laxity in " << steps << " steps" << std::endl;
+    return aSolution;
+}
+
+//shared state of one branch-and-bound run, tasks are assigned in mOrder and tried on cores in mCores order
+struct BranchSearch {
+    std::vector<int> mOrder;
+    std::vector<int> mCores;
+    //cheapest possible cost of the tasks from depth k on, each on the fastest core
+    std::vector<double> mSuffixBound;
+    std::atomic<double> mBestCost;
+    std::vector<int> mBestAssignment;
+    std::mutex mBestMutex;
+    std::atomic<bool> mStop;
+    std::atomic<bool> mGapReached;
+    std::atomic<long long> mNodes;
+    std::chrono::steady_clock::time_point mDeadline;
+}typedef BranchSearch;
+
+//the partial assignment one worker is extending, mAssignment holds the flat core of every task id or -1
+struct BranchState {
+    std::vector<double> mLoads;
+    std::vector<int> mTaskCounts;
+    std::vector<int> mAssignment;
+    int mEmptyCores;
+    double mCost;
+    long long mNodes;
+}typedef BranchState;
+
+//try to put the task at aDepth of the order on aCore, returns false without changing the state if that breaks a deadline,
+//leaves more empty cores than tasks or cannot beat the incumbent
+bool branchPlace(const ProblemInstance& aInstance, BranchSearch& aSearch, BranchState& aState, int aDepth, int aCore)
+{
+    int task = aSearch.mOrder[aDepth];
+    double load = aState.mLoads[aCore] + taskLoad(aInstance, task, aInstance.mFlatCores[aCore].first, aInstance.mFlatCores[aCore].second);
+    if(load > 1.0 + loadTolerance)
+        return false;
+    int emptyCores = aState.mEmptyCores - (aState.mTaskCounts[aCore] == 0 ? 1 : 0);
+    if(emptyCores > (int)aSearch.mOrder.size() - aDepth - 1)
+        return false;
+    double cost = aState.mCost + aInstance.mTasks.at(task).mWcet * coreFactor(aInstance, aCore);
+    if(cost + aSearch.mSuffixBound[aDepth + 1] >= aSearch.mBestCost - loadTolerance)
+        return false;
+
+    aState.mLoads[aCore] = load;
+    aState.mTaskCounts[aCore]++;
+    aState.mAssignment[task] = aCore;
+    aState.mEmptyCores = emptyCores;
+    aState.mCost = cost;
+    return true;
+}
+
+void branchRemove(const ProblemInstance& aInstance, BranchSearch& aSearch, BranchState& aState, int aDepth, int aCore)
+{
+    int task = aSearch.mOrder[aDepth];
+    aState.mLoads[aCore] -= taskLoad(aInstance, task, aInstance.mFlatCores[aCore].first, aInstance.mFlatCores[aCore].second);
+    if(--aState.mTaskCounts[aCore] == 0)
+        aState.mEmptyCores++;
+    aState.mAssignment[task] = -1;
+    aState.mCost -= aInstance.mTasks.at(task).mWcet * coreFactor(aInstance, aCore);
+}
+
+//empty cores of one class are interchangeable, so only the first of them is branched on. The cores are sorted by factor,
+//which keeps every class together, and aLastEmptyClass remembers the class of the last empty core tried at this node
+bool branchSymmetric(const ProblemInstance& aInstance, const BranchState& aState, int aCore, int& aLastEmptyClass)
+{
+    if(aState.mTaskCounts[aCore] > 0)
+        return false;
+    if(aInstance.mCoreClass[aCore] == aLastEmptyClass)
+        return true;
+    aLastEmptyClass = aInstance.mCoreClass[aCore];
+    return false;
+}
+
+//depth first search below aDepth, the cores are tried fastest first so the first leaves found are good incumbents
+void branch(SolverContext& aContext, BranchSearch& aSearch, BranchState& aState, int aDepth)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    if((++aState.mNodes & 0xFFFF) == 0 && std::chrono::steady_clock::now() > aSearch.mDeadline)
+        aSearch.mStop = true;
+    if(aSearch.mStop)
+        return;
+
+    if(aDepth == (int)aSearch.mOrder.size())
+    {
+        std::lock_guard<std::mutex> lock(aSearch.mBestMutex);
+        if(aState.mCost < aSearch.mBestCost)
+        {
+            aSearch.mBestCost = aState.mCost;
+            aSearch.mBestAssignment = aState.mAssignment;
+            reportGap(aContext, "Branch and bound", instance.mDeadlineSum - aState.mCost);
+            if(withinTargetGap(aContext, instance.mDeadlineSum - aState.mCost))
+            {
+                aSearch.mGapReached = true;
+                aSearch.mStop = true;
+            }
+        }
+        return;
+    }
+
+    int lastEmptyClass = -1;
+    for(int core : aSearch.mCores)
+    {
+        if(branchSymmetric(instance, aState, core, lastEmptyClass) || !branchPlace(instance, aSearch, aState, aDepth, core))
+            continue;
+        branch(aContext, aSearch, aState, aDepth + 1);
+        branchRemove(instance, aSearch, aState, aDepth, core);
+    }
+}
+
+//exact search for the highest laxity by depth first branch and bound, the start solution is the first incumbent
+//the top of the tree is cut into subtrees that the worker threads take from their own queue and steal from the others when it runs dry
+std::vector<std::tuple<int, int, int>> runBranchAndBound(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    BranchSearch search;
+    search.mOrder.resize(instance.mTasks.size());
+    for(unsigned i = 0; i < instance.mTasks.size(); ++i)
+        search.mOrder[i] = i;
+    std::stable_sort(search.mOrder.begin(), search.mOrder.end(), [&instance](int a, int b){ return instance.mTasks.at(a).mWcet > instance.mTasks.at(b).mWcet; });
+    search.mCores.resize(instance.mCoreCount);
+    for(int c = 0; c < instance.mCoreCount; ++c)
+        search.mCores[c] = c;
+    std::stable_sort(search.mCores.begin(), search.mCores.end(), [&instance](int a, int b){ return coreFactor(instance, a) < coreFactor(instance, b); });
+
+    double fastest = coreFactor(instance, search.mCores.front());
+    search.mSuffixBound.assign(instance.mTasks.size() + 1, 0.0);
+    for(int k = instance.mTasks.size() - 1; k >= 0; --k)
+        search.mSuffixBound[k] = search.mSuffixBound[k + 1] + instance.mTasks.at(search.mOrder[k]).mWcet * fastest;
+
+    search.mBestCost = instance.mDeadlineSum - calculateLaxity(instance, initialSolution);
+    search.mBestAssignment.assign(instance.mTasks.size(), -1);
+    for(auto& element : initialSolution)
+        search.mBestAssignment[std::get<0>(element)] = flatCoreOf(instance, element);
+    search.mGapReached = withinTargetGap(aContext, instance.mDeadlineSum - search.mBestCost);
+    search.mStop = search.mGapReached.load();
+    search.mNodes = 0;
+    auto start = std::chrono::steady_clock::now();
+    search.mDeadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(aContext.mExactTimeLimit));
+    if(aContext.mTimeBudget > 0)
+        search.mDeadline = std::min(search.mDeadline, aContext.mStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(aContext.mTimeBudget)));
+
+    BranchState root;
+    root.mLoads.assign(instance.mCoreCount, 0.0);
+    root.mTaskCounts.assign(instance.mCoreCount, 0);
+    root.mAssignment.assign(instance.mTasks.size(), -1);
+    root.mEmptyCores = instance.mCoreCount;
+    root.mCost = 0;
+    root.mNodes = 0;
+
+    //expand the tree breadth first until there are enough subtrees to keep every thread busy, a subtree is the cores of its first tasks
+    std::vector<std::vector<int>> frontier(1);
+    int splitDepth = 0;
+    while(splitDepth < (int)instance.mTasks.size() && frontier.size() < 32 * aContext.mThreadCount)
+    {
+        std::vector<std::vector<int>> next;
+        for(auto& prefix : frontier)
+        {
+            BranchState state = root;
+            for(int d = 0; d < splitDepth; ++d)
+                branchPlace(instance, search, state, d, prefix[d]);
+            int lastEmptyClass = -1;
+            for(int core : search.mCores)
+            {
+                if(branchSymmetric(instance, state, core, lastEmptyClass) || !branchPlace(instance, search, state, splitDepth, core))
+                    continue;
+                next.push_back(prefix);
+                next.back().push_back(core);
+                branchRemove(instance, search, state, splitDepth, core);
+            }
+        }
+        frontier.swap(next);
+        splitDepth++;
+    }
+
+    std::vector<std::deque<std::vector<int>>> queues(aContext.mThreadCount);
+    std::vector<std::mutex> queueMutexes(aContext.mThreadCount);
+    for(unsigned i = 0; i < frontier.size(); ++i)
+        queues[i % aContext.mThreadCount].push_back(frontier[i]);
+
+    auto worker = [&](int self) {
+        long long nodes = 0;
+        while(!search.mStop)
+        {
+            std::vector<int> prefix;
+            bool found = false;
+            for(unsigned k = 0; k < aContext.mThreadCount && !found; ++k)
+            {
+                int victim = (self + k) % aContext.mThreadCount;
+                std::lock_guard<std::mutex> lock(queueMutexes[victim]);
+                if(queues[victim].empty())
+                    continue;
+                //own work comes from the front, stolen work from the back where the other worker will get to it last
+                if(k == 0)
+                {
+                    prefix = queues[victim].front();
+                    queues[victim].pop_front();
+                }
+                else
+                {
+                    prefix = queues[victim].back();
+                    queues[victim].pop_back();
+                }
+                found = true;
+            }
+            if(!found)
+                break;
+
+            BranchState state = root;
+            bool valid = true;
+            for(int d = 0; d < splitDepth && valid; ++d)
+                valid = branchPlace(instance, search, state, d, prefix[d]);
+            if(valid)
+                branch(aContext, search, state, splitDepth);
+            nodes += state.mNodes;
+        }
+        search.mNodes += nodes;
+    };
+    ThreadPool& pool = contextPool(aContext);
+    pool.parallelFor(aContext.mThreadCount, worker);
+    aContext.mIterations += search.mNodes;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    *aContext.mLog << "Branch and bound: " << search.mNodes << " nodes in " << seconds << " s, " << search.mNodes / seconds << " nodes/s on " << aContext.mThreadCount << " threads" << std::endl;
+    if(search.mGapReached)
+        *aContext.mLog << "Target gap reached, stopped early" << std::endl;
+    else if(search.mStop)
+        *aContext.mLog << "Time limit reached, the best laxity found is not proven optimal" << std::endl;
+    else
+        *aContext.mLog << "Optimal laxity proven: " << instance.mDeadlineSum - search.mBestCost << std::endl;
+
+    std::vector<std::tuple<int, int, int>> solution;
+    for(unsigned task = 0; task < instance.mTasks.size(); ++task)
+    {
+        int core = search.mBestAssignment[task];
+        solution.push_back(std::make_tuple(task, instance.mFlatCores[core].first, instance.mFlatCores[core].second));
+    }
+
+    return solution;
+}
+
+//apply a delta file to the task set and to a solution that holds task i in entry i, only the cores of the changed tasks are touched
+//  <Delta>
+//    <Add Id="300" Deadline="10000" Period="10000" WCET="120" />
+//    <Remove Id="26" />
+//    <Update Id="27" WCET="60" />           any of Deadline, Period and WCET
+//  </Delta>
+//added tasks go to the cheapest core they fit on, a removed task's entry is filled with the last one so the entries stay in task order
+//aChanged gets the entries of the added and updated tasks and aFreedCores the flat cores removed tasks were taken off,
+//returns false if the file cannot be read
+bool applyDelta(ProblemInstance& aInstance, const std::string& aPath, std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState, std::vector<unsigned>& aChanged, std::vector<int>& aFreedCores, std::ostream& aLog)
+{
+    pugi::xml_document doc;
+    if(!doc.load_file(aPath.c_str()))
+    {
+        aLog << "Could not read " << aPath << std::endl;
+        return false;
+    }
+
+    std::unordered_map<int, int> taskIndex;
+    for(unsigned i = 0; i < aInstance.mTasks.size(); ++i)
+        taskIndex[aInstance.mTasks[i].mId] = i;
+    std::vector<char> changed(aInstance.mTasks.size(), 0);
+    aFreedCores.clear();
+
+    auto unassign = [&aInstance, &aSolution, &aState](int aTask) {
+        int core = flatCoreOf(aInstance, aSolution[aTask]);
+        aState.mLoads[core] -= taskLoad(aInstance, aTask, aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second);
+        aState.mTaskCounts[core]--;
+    };
+    auto assign = [&aInstance, &aSolution, &aState](int aTask, int aCore) {
+        aSolution[aTask] = std::make_tuple(aTask, aInstance.mFlatCores[aCore].first, aInstance.mFlatCores[aCore].second);
+        aState.mLoads[aCore] += taskLoad(aInstance, aTask, aInstance.mFlatCores[aCore].first, aInstance.mFlatCores[aCore].second);
+        aState.mTaskCounts[aCore]++;
+    };
+
+    int added = 0, removed = 0, updated = 0, unknown = 0;
+    for(pugi::xml_node change : doc.child("Delta").children())
+    {
+        std::string kind = change.name();
+        int id = change.attribute("Id").as_int();
+        auto found = taskIndex.find(id);
+
+        if(kind == "Add" && found == taskIndex.end())
+        {
+            Task t;
+            t.mDeadline = change.attribute("Deadline").as_int();
+            t.mId = id;
+            t.mPeriod = change.attribute("Period").as_int();
+            t.mWcet = change.attribute("WCET").as_int();
+            t.mPriority = 1.0 / (double)t.mDeadline;
+            aInstance.mTasks.push_back(t);
+            aInstance.mDeadlineSum += t.mDeadline;
+
+            int task = aInstance.mTasks.size() - 1;
+            taskIndex[id] = task;
+            changed.push_back(1);
+            aSolution.emplace_back();
+            assign(task, cheapestCore(aInstance, task, aState.mLoads));
+            added++;
+        }
+        else if(kind == "Remove" && found != taskIndex.end())
+        {
+            int task = found->second;
+            int last = aInstance.mTasks.size() - 1;
+            aFreedCores.push_back(flatCoreOf(aInstance, aSolution[task]));
+            unassign(task);
+            aInstance.mDeadlineSum -= aInstance.mTasks[task].mDeadline;
+            taskIndex.erase(found);
+            if(task != last)
+            {
+                aInstance.mTasks[task] = aInstance.mTasks[last];
+                std::get<0>(aSolution[last]) = task;
+                aSolution[task] = aSolution[last];
+                changed[task] = changed[last];
+                taskIndex[aInstance.mTasks[task].mId] = task;
+            }
+            aInstance.mTasks.pop_back();
+            aSolution.pop_back();
+            changed.pop_back();
+            removed++;
+        }
+        else if(kind == "Update" && found != taskIndex.end())
+        {
+            int task = found->second;
+            int core = flatCoreOf(aInstance, aSolution[task]);
+            unassign(task);
+            aInstance.mDeadlineSum -= aInstance.mTasks[task].mDeadline;
+            aInstance.mTasks[task].mDeadline = change.attribute("Deadline").as_int(aInstance.mTasks[task].mDeadline);
+            aInstance.mTasks[task].mPeriod = change.attribute("Period").as_int(aInstance.mTasks[task].mPeriod);
+            aInstance.mTasks[task].mWcet = change.attribute("WCET").as_int(aInstance.mTasks[task].mWcet);
+            aInstance.mTasks[task].mPriority = 1.0 / (double)aInstance.mTasks[task].mDeadline;
+            aInstance.mDeadlineSum += aInstance.mTasks[task].mDeadline;
+            assign(task, core);
+            changed[task] = 1;
+            updated++;
+        }
+        else
+        {
+            unknown++;
+        }
+    }
+
+    aChanged.clear();
+    for(unsigned task = 0; task < aInstance.mTasks.size(); ++task)
+    {
+        if(changed[task])
+            aChanged.push_back(task);
+    }
+
+    aLog << "Delta " << aPath << ": " << added << " added, " << removed << " removed, " << updated << " updated";
+    if(unknown > 0)
+        aLog << ", " << unknown << " changes ignored for unknown or existing ids";
+    aLog << std::endl;
+    return true;
+}
+
+//repair the cores a delta broke and run a best-improvement search limited to the tasks on the cores the delta or the repair
+//touched: the cores of the changed tasks, the cores removed tasks freed and every core the repair moved a task off or onto
+std::vector<std::tuple<int, int, int>> reoptimiseDelta(SolverContext& aContext, std::vector<std::tuple<int, int, int>> aSolution, CoreState& aState, const std::vector<unsigned>& aChanged, const std::vector<int>& aFreedCores)
+{
+    const ProblemInstance& instance = *aContext.mInstance;
+    std::vector<int> coresBefore(aSolution.size());
+    for(unsigned e = 0; e < aSolution.size(); ++e)
+        coresBefore[e] = flatCoreOf(instance, aSolution[e]);
+    if(!repairSolution(instance, aSolution, aState))
+    {
+        *aContext.mLog << "Could not repair the solution after the delta" << std::endl;
+        return {};
+    }
+
+    std::vector<char> touched(instance.mCoreCount, 0);
+    for(unsigned entry : aChanged)
+        touched[flatCoreOf(instance, aSolution[entry])] = 1;
+    for(int core : aFreedCores)
+        touched[core] = 1;
+    for(unsigned e = 0; e < aSolution.size(); ++e)
+    {
+        int core = flatCoreOf(instance, aSolution[e]);
+        if(core != coresBefore[e])
+        {
+            touched[coresBefore[e]] = 1;
+            touched[core] = 1;
+        }
+    }
+    std::vector<unsigned> focus;
+    for(unsigned e = 0; e < aSolution.size(); ++e)
+    {
+        if(touched[flatCoreOf(instance, aSolution[e])])
+            focus.push_back(e);
+    }
+    if(focus.empty())
+        return aSolution;
+
+    *aContext.mLog << "Focused search over " << focus.size() << " of " << aSolution.size() << " tasks" << std::endl;
+    return polishSolution(aContext, aSolution, focus);
+}
+
+//append the decimal digits of aValue to aBuffer
+void appendNumber(std::string& aBuffer, long long aValue)
+{
+    char digits[24];
+    char* end = std::to_chars(digits, digits + sizeof(digits), aValue).ptr;
+    aBuffer.append(digits, end);
+}
+
+//save solution to xml, the lines are formatted into one buffer that is written with a single call
+//the entries are grouped by core with a counting sort instead of going through a DOM
+bool writeOutput(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution, const std::string& aFilepath, bool aEcho, std::ostream& aLog, const std::string& aPrefix)
+{
+    PROFILE_SCOPE(PhaseOutput);
+    std::vector<unsigned> coreStart(aInstance.mCoreCount + 1, 0);
+    for(auto& element : aSolution)
+        coreStart[flatCoreOf(aInstance, element) + 1]++;
+    for(int core = 0; core < aInstance.mCoreCount; ++core)
+        coreStart[core + 1] += coreStart[core];
+    std::vector<unsigned> order(aSolution.size());
+    for(unsigned i = 0; i < aSolution.size(); ++i)
+        order[coreStart[flatCoreOf(aInstance, aSolution[i])]++] = i;
+
+    std::string out;
+    out.reserve(aSolution.size() * 64 + 128);
+    out += "<?xml version=\"1.0\"?>\n<solution>\n";
+    for(unsigned i : order)
+    {
+        const auto& sol = aSolution[i];
+        const MCP& mcp = aInstance.mPlatform.at(std::get<1>(sol));
+        //the ids from the model, the solution itself holds positions
+        out += "  <Task Id=\"";
+        appendNumber(out, aInstance.mTasks.at(std::get<0>(sol)).mId);
+        out += "\" MCP=\"";
+        appendNumber(out, mcp.mId);
+        out += "\" Core=\"";
+        appendNumber(out, mcp.mCores.at(std::get<2>(sol)).mId);
+        out += "\" WCRT=\"";
+        appendNumber(out, llround(aInstance.mTasks.at(std::get<0>(sol)).mWcet * mcp.mCores.at(std::get<2>(sol)).mWcetFactor));
+        out += "\" />\n";
+    }
+    out += "</solution>\n<!--Total Laxity: ";
+    appendNumber(out, llround(calculateLaxity(aInstance, aSolution)));
+    out += "-->\n";
+
+    if(aEcho)
+        std::cout << out;
+
+    //aPrefix goes in front of the file name, so an instance in another directory gets its solution next to it
+    std::string filename = aFilepath;
+    filename.insert(filename.find_last_of('/') + 1, aPrefix);
+    FILE* file = fopen(filename.c_str(), "wb");
+    if(!file || fwrite(out.data(), 1, out.size(), file) != out.size())
+    {
+        aLog << "Could not write " << filename << std::endl;
+        if(file)
+            fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    aLog << filename << std::endl;
+    return true;
+}
+
+//the fastest core aTask fits on with the given loads, a task that fits nowhere gets the core it overloads least
+int cheapestCore(const ProblemInstance& aInstance, int aTask, const std::vector<double>& aLoads)
+{
+    int best = 0;
+    for(int core = 1; core < aInstance.mCoreCount; ++core)
+    {
+        double load = aLoads[core] + taskLoad(aInstance, aTask, aInstance.mFlatCores[core].first, aInstance.mFlatCores[core].second);
+        double bestLoad = aLoads[best] + taskLoad(aInstance, aTask, aInstance.mFlatCores[best].first, aInstance.mFlatCores[best].second);
+        bool fits = load <= 1.0 + loadTolerance;
+        bool bestFits = bestLoad <= 1.0 + loadTolerance;
+        if(fits != bestFits ? fits : (fits ? coreFactor(aInstance, core) < coreFactor(aInstance, best) : load < bestLoad))
+            best = core;
+    }
+    return best;
+}
+
+//read a solution file of this or an earlier version of the instance and make it a feasible start, the ids are mapped back to
+//positions, entries for unknown tasks, MCPs or cores and repeated tasks are dropped, tasks the file misses go to the cheapest
+//core they fit on, then overloaded and empty cores are repaired. Returns an empty vector if that does not give a feasible solution
+std::vector<std::tuple<int, int, int>> loadSolution(const ProblemInstance& aInstance, const std::string& aPath, std::ostream& aLog)
+{
+    pugi::xml_document doc;
+    if(!doc.load_file(aPath.c_str()))
+    {
+        aLog << "Could not read " << aPath << std::endl;
+        return {};
+    }
+
+    std::unordered_map<int, int> taskIndex;
+    for(unsigned i = 0; i < aInstance.mTasks.size(); ++i)
+        taskIndex[aInstance.mTasks[i].mId] = i;
+    std::unordered_map<int, int> mcpIndex;
+    std::vector<std::unordered_map<int, int>> coreIndex(aInstance.mPlatform.size());
+    for(unsigned m = 0; m < aInstance.mPlatform.size(); ++m)
+    {
+        mcpIndex[aInstance.mPlatform[m].mId] = m;
+        for(unsigned c = 0; c < aInstance.mPlatform[m].mCores.size(); ++c)
+            coreIndex[m][aInstance.mPlatform[m].mCores[c].mId] = c;
+    }
+
+    std::vector<int> assignment(aInstance.mTasks.size(), -1);
+    int dropped = 0;
+    pugi::xml_node root = doc.child("solution") ? doc.child("solution") : doc.child("Solution");
+    for(pugi::xml_node entry : root.children("Task"))
+    {
+        auto task = taskIndex.find(entry.attribute("Id").as_int());
+        auto mcp = mcpIndex.find(entry.attribute("MCP").as_int());
+        if(task == taskIndex.end() || assignment[task->second] >= 0 || mcp == mcpIndex.end())
+        {
+            dropped++;
+            continue;
+        }
+        auto core = coreIndex[mcp->second].find(entry.attribute("Core").as_int());
+        if(core == coreIndex[mcp->second].end())
+        {
+            dropped++;
+            continue;
+        }
+        assignment[task->second] = aInstance.mCoreOffset[mcp->second] + core->second;
+    }
+
+    std::vector<double> loads(aInstance.mCoreCount, 0.0);
+    for(unsigned task = 0; task < aInstance.mTasks.size(); ++task)
+    {
+        if(assignment[task] >= 0)
+            loads[assignment[task]] += taskLoad(aInstance, task, aInstance.mFlatCores[assignment[task]].first, aInstance.mFlatCores[assignment[task]].second);
+    }
+
+    int placed = 0;
+    for(unsigned task = 0; task < aInstance.mTasks.size(); ++task)
+    {
+        if(assignment[task] >= 0)
+            continue;
+        int best = cheapestCore(aInstance, task, loads);
+        assignment[task] = best;
+        loads[best] += taskLoad(aInstance, task, aInstance.mFlatCores[best].first, aInstance.mFlatCores[best].second);
+        placed++;
+    }
+
+    std::vector<std::tuple<int, int, int>> solution;
+    solution.reserve(aInstance.mTasks.size());
+    for(unsigned task = 0; task < aInstance.mTasks.size(); ++task)
+        solution.push_back(std::make_tuple(task, aInstance.mFlatCores[assignment[task]].first, aInstance.mFlatCores[assignment[task]].second));
+
+    bool repaired = !check(aInstance, solution);
+    if(repaired && !repairSolution(aInstance, solution))
+    {
+        aLog << "Could not repair " << aPath << " into a feasible solution" << std::endl;
+        return {};
+    }
+
+    aLog << "Loaded " << aPath << ": " << dropped << " entries dropped, " << placed << " tasks placed" << (repaired ? ", repaired" : "") << std::endl;
+    return solution;
+}
+
+std::string taggedPath(const std::string& aPath, const std::string& aTag)
+{
+    size_t name = aPath.find_last_of('/') + 1;
+    size_t extension = aPath.find_last_of('.');
+    std::string path = aPath;
+    path.insert(extension != std::string::npos && extension > name ? extension : path.size(), "." + aTag);
+    return path;
+}
+
+bool isSolveMode(const std::string& aMode)
+{
+    return aMode == "sa" || aMode == "penalty" || aMode == "tabu" || aMode == "ga" || aMode == "lns" || aMode == "exact";
+}
+
+//run the search engine named by aMode from aStart, returns an empty vector for an unknown mode
+std::vector<std::tuple<int, int, int>> runEngine(SolverContext& aContext, const std::string& aMode, std::vector<std::tuple<int, int, int>>& aStart)
+{
+    PROFILE_SCOPE(PhaseSearch);
+    if(aMode == "sa")
+        return runSimulatedAnnealing(aContext, aStart);
+    if(aMode == "penalty")
+        return runPenaltyAnnealing(aContext, aStart);
+    if(aMode == "tabu")
+        return runTabuSearch(aContext, aStart);
+    if(aMode == "ga")
+        return runGeneticAlgorithm(aContext, aStart);
+    if(aMode == "lns")
+        return runLargeNeighbourhoodSearch(aContext, aStart);
+    if(aMode == "exact")
+        return runBranchAndBound(aContext, aStart);
+    return {};
+}
+
+//apply a delta file to a copy of the instance and to the solution of it in aWarmStart, then repair and search only around
+//the changed tasks. The context is moved to the changed instance, the one it started from is left as it was for other solves
+std::vector<std::tuple<int, int, int>> solveDelta(SolverContext& aContext, const std::string& aWarmStart, const std::string& aDelta)
+{
+    std::vector<std::tuple<int, int, int>> solution = loadSolution(*aContext.mInstance, aWarmStart, *aContext.mLog);
+    if(solution.empty())
+        return {};
+
+    std::shared_ptr<ProblemInstance> changedInstance = std::make_shared<ProblemInstance>(*aContext.mInstance);
+    CoreState state = buildCoreState(*changedInstance, solution);
+    std::vector<unsigned> changed;
+    std::vector<int> freedCores;
+    if(!applyDelta(*changedInstance, aDelta, solution, state, changed, freedCores, *aContext.mLog))
+        return {};
+    computeLaxityBounds(*changedInstance, *aContext.mLog);
+    aContext.mInstance = changedInstance;
+    return reoptimiseDelta(aContext, solution, state, changed, freedCores);
+}
+
+//search aContext.mInstance with the given options and write the solution next to aOutputPath
+//a delta result is written as the solution of the delta file, since it no longer fits the instance file
+SolveResult solve(SolverContext& aContext, const std::string& aOutputPath, const SolveOptions& aOptions)
+{
+    SolveResult result;
+    aContext.mStart = std::chrono::steady_clock::now();
+    aContext.mIterations = 0;
+
+    //an unknown mode is reported before any work is done for it
+    if(aOptions.mDelta.empty() && !isSolveMode(aOptions.mMode))
+    {
+        *aContext.mLog << "Unknown mode: " << aOptions.mMode << std::endl;
+        return result;
+    }
+
+    std::vector<std::tuple<int, int, int>> solution;
+    if(!aOptions.mDelta.empty())
+    {
+        solution = solveDelta(aContext, aOptions.mWarmStart, aOptions.mDelta);
+        if(solution.empty())
+            return result;
+    }
+    else
+    {
+        const ProblemInstance& instance = *aContext.mInstance;
+        std::vector<std::vector<std::tuple<int, int, int>>> starts;
+        if(!aOptions.mWarmStart.empty())
+        {
+            //a warm start that cannot be used fails the solve, a new construction would silently throw the old solution away
+            std::vector<std::tuple<int, int, int>> start = loadSolution(instance, aOptions.mWarmStart, *aContext.mLog);
+            if(start.empty())
+                return result;
+            starts.push_back(start);
+            //about what moving one task is worth, so the annealing takes small losses around the old solution but does not scramble it
+            aContext.mStartTemperature = 0;
+            for(auto& task : instance.mTasks)
+                aContext.mStartTemperature += task.mWcet;
+            aContext.mStartTemperature /= instance.mTasks.size();
+        }
+        if(starts.empty() && aOptions.mGraspCount > 0)
+            starts = createGraspSolutions(aContext, aOptions.mGraspCount, 3);
+        if(starts.empty())
+            starts.push_back(createInitialSolution(aContext));
+        if(starts.front().empty())
+            return result;
+
+        //every start is searched from and the result with the highest laxity is kept, a start the search could not improve on
+        //is kept itself, so a warm start never ends below the solution it resumes
+        for(auto& start : starts)
+        {
+            if(calculateLaxity(instance, start) > result.mLaxity)
+            {
+                result.mLaxity = calculateLaxity(instance, start);
+                solution = start;
+            }
+            std::vector<std::tuple<int, int, int>> found = runEngine(aContext, aOptions.mMode, start);
+            if(found.empty())
+            {
+                *aContext.mLog << "Unknown mode: " << aOptions.mMode << std::endl;
+                return result;
+            }
+            if(calculateLaxity(instance, found) > result.mLaxity)
+            {
+                result.mLaxity = calculateLaxity(instance, found);
+                solution = found;
+            }
+        }
+    }
+
+    if(aOptions.mPolish)
+        solution = polishSolution(aContext, solution);
+    result.mLaxity = calculateLaxity(*aContext.mInstance, solution);
+
+    reportGap(aContext, "Final", result.mLaxity);
+    //a delta solution belongs to the changed instance, the prefix keeps it apart from the solutions of the model itself
+    std::string outputPath = aOutputPath;
+    std::string prefix = aOptions.mDelta.empty() ? "solution_" : "delta_solution_";
+    if(!aOptions.mSolutionTag.empty())
+        outputPath = taggedPath(outputPath, aOptions.mSolutionTag);
+    result.mSolved = !aOptions.mWriteSolution || writeOutput(*aContext.mInstance, solution, outputPath, aOptions.mPrintSolution, *aContext.mLog, prefix);
+    result.mSeconds = elapsedSeconds(aContext);
+    result.mIterations = aContext.mIterations;
+    if(aOptions.mWriteSolution)
+    {
+        result.mSolutionPath = outputPath;
+        result.mSolutionPath.insert(result.mSolutionPath.find_last_of('/') + 1, prefix);
+    }
+    result.mSolution = std::move(solution);
+    return result;
+}
@@ -0,0 +1,89 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+//internals of libtaskalloc shared by the solver, the benchmark and the validator, programs that only solve need taskalloc.hpp
+
+#include "taskalloc.hpp"
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//a neighbourhood step, a move sends entry mFirst to core (mMcp, mCore), a swap exchanges the cores of entries mFirst and mSecond
+struct Move {
+    bool mSwap;
+    unsigned mFirst;
+    unsigned mSecond;
+    int mMcp;
+    int mCore;
+}typedef Move;
+
+//per-core bookkeeping so a move can be checked and applied without rescanning the whole solution
+struct CoreState {
+    std::vector<double> mLoads;
+    std::vector<int> mTaskCounts;
+}typedef CoreState;
+
+extern const double loadTolerance;
+
+void addCores(ProblemInstance& aInstance, int aMcp);
+void computeLaxityBounds(ProblemInstance& aInstance, std::ostream& aLog);
+
+bool withinTargetGap(SolverContext& aContext, double aLaxity);
+double elapsedSeconds(SolverContext& aContext);
+bool timeBudgetExpired(SolverContext& aContext);
+void notifyProgress(SolverContext& aContext, const std::string& aStage, double aLaxity);
+void reportGap(SolverContext& aContext, const std::string& aStage, double aLaxity);
+ThreadPool& contextPool(SolverContext& aContext);
+
+double taskLoad(const ProblemInstance& aInstance, int task, int mcp, int core);
+double coreFactor(const ProblemInstance& aInstance, int aFlatCore);
+int flatCoreOf(const ProblemInstance& aInstance, const std::tuple<int, int, int>& element);
+bool checkIfAllCoreHasTasks(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>> solution);
+bool checkCoreDeadline(const ProblemInstance& aInstance, int i, int j, std::vector<std::tuple<int, int, int>> aSolution);
+bool checkDeadline(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>> aSolution);
+bool check(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>> aSolution);
+double calculateLaxity(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution);
+std::vector<double> calculateCoreLoads(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution);
+double calculateOverload(const std::vector<double>& loads);
+std::vector<int> canonicalAssignment(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution);
+
+std::vector<std::tuple<int, int, int>> createGreedySolution(const ProblemInstance& aInstance, std::mt19937* aRandom = nullptr, double aAlpha = 0.0);
+std::vector<std::tuple<int, int, int>> createRandomSolution(SolverContext& aContext, int aAttempts);
+bool reportInfeasibility(const ProblemInstance& aInstance, std::ostream& aLog);
+std::vector<std::tuple<int, int, int>> createInitialSolution(SolverContext& aContext);
+std::vector<std::vector<std::tuple<int, int, int>>> createGraspSolutions(SolverContext& aContext, int aCount, int aKeep);
+
+CoreState buildCoreState(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution);
+double moveLaxityDelta(const ProblemInstance& aInstance, const Move& aMove, const std::vector<std::tuple<int, int, int>>& aSolution);
+bool moveIsFeasible(const ProblemInstance& aInstance, const Move& aMove, const std::vector<std::tuple<int, int, int>>& aSolution, const CoreState& aState);
+void applyMove(const ProblemInstance& aInstance, const Move& aMove, std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState);
+Move randomRelocation(SolverContext& aContext, const std::vector<std::tuple<int, int, int>>& aSolution);
+Move randomSwap(SolverContext& aContext, const std::vector<std::tuple<int, int, int>>& aSolution);
+std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodSwap(SolverContext& aContext, std::vector<std::tuple<int, int, int>> solution);
+std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodMove(SolverContext& aContext, std::vector<std::tuple<int, int, int>> solution, bool* aSwapped = nullptr);
+std::vector<std::tuple<int, int, int>> selectRandomNeighbourhoodSolution(SolverContext& aContext, int random, std::vector<std::tuple<int, int, int>> solution, bool* aSwapped = nullptr);
+bool calculateProbability(SolverContext& aContext, double delta, double temp);
+bool repairSolution(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>>& aSolution);
+bool repairSolution(const ProblemInstance& aInstance, std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState);
+
+std::vector<std::tuple<int, int, int>> runSimulatedAnnealing(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution);
+std::vector<std::tuple<int, int, int>> runPenaltyAnnealing(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution);
+std::vector<std::tuple<int, int, int>> runTabuSearch(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution);
+std::vector<std::tuple<int, int, int>> runGeneticAlgorithm(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution);
+std::vector<std::tuple<int, int, int>> runLargeNeighbourhoodSearch(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution);
+std::vector<std::tuple<int, int, int>> runBranchAndBound(SolverContext& aContext, std::vector<std::tuple<int, int, int>> &initialSolution);
+std::vector<std::tuple<int, int, int>> runEngine(SolverContext& aContext, const std::string& aMode, std::vector<std::tuple<int, int, int>>& aStart);
+std::vector<std::tuple<int, int, int>> polishSolution(SolverContext& aContext, std::vector<std::tuple<int, int, int>> aSolution, const std::vector<unsigned>& aFocus = {});
+
+int cheapestCore(const ProblemInstance& aInstance, int aTask, const std::vector<double>& aLoads);
+std::vector<std::tuple<int, int, int>> loadSolution(const ProblemInstance& aInstance, const std::string& aPath, std::ostream& aLog);
+bool applyDelta(ProblemInstance& aInstance, const std::string& aPath, std::vector<std::tuple<int, int, int>>& aSolution, CoreState& aState, std::vector<unsigned>& aChanged, std::vector<int>& aFreedCores, std::ostream& aLog);
+std::vector<std::tuple<int, int, int>> reoptimiseDelta(SolverContext& aContext, std::vector<std::tuple<int, int, int>> aSolution, CoreState& aState, const std::vector<unsigned>& aChanged, const std::vector<int>& aFreedCores);
+bool writeOutput(const ProblemInstance& aInstance, const std::vector<std::tuple<int, int, int>>& aSolution, const std::string& aFilepath, bool aEcho, std::ostream& aLog, const std::string& aPrefix = "solution_");
+std::vector<std::tuple<int, int, int>> solveDelta(SolverContext& aContext, const std::string& aWarmStart, const std::string& aDelta);
+
+#endif
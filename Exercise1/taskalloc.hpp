@@ -0,0 +1,186 @@
+#ifndef TASKALLOC_HPP
+#define TASKALLOC_HPP
+
+//libtaskalloc: assigns periodic tasks to the cores of multicore processors so every core meets its deadlines under EDF
+//and the total laxity is as high as possible. A ProblemInstance is read once and never changed, every solve gets its own
+//SolverContext, so any number of solves can run at the same time on the same or on different instances
+//
+//  std::shared_ptr<const ProblemInstance> instance = loadInstance("large.xml");
+//  SolverContext context(instance);
+//  context.mTimeBudget = 1;
+//  SolveResult result = solve(context, "large.xml", SolveOptions());
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <math.h>
+
+struct Task {
+    int mDeadline;
+    int mId;
+    int mPeriod;
+    double mWcet;
+    double mPriority;
+}typedef Task;
+
+struct Core {
+    int mId;
+    double mWcetFactor;
+}typedef Core;
+
+struct MCP {
+    int mId;
+    std::vector<Core> mCores;
+}typedef MCP;
+
+//upper bounds on the laxity any feasible solution can reach, computed after the instance is read
+struct LaxityBounds {
+    //every task on the fastest core
+    double mTrivial;
+    //fractional assignment that respects the capacity of every core
+    double mRelaxed;
+}typedef LaxityBounds;
+
+//a parsed Model file and everything derived from it, shared read-only by all solves of it
+struct ProblemInstance {
+    std::vector<Task> mTasks;
+    std::vector<MCP> mPlatform;
+    long long mDeadlineSum = 0;
+    //flat index of the first core of every MCP, a core's flat index is mCoreOffset[mcp] + core
+    std::vector<int> mCoreOffset;
+    int mCoreCount = 0;
+    //mcp and core position of every flat core index
+    std::vector<std::pair<int, int>> mFlatCores;
+    //cores with the same WCET factor are interchangeable, mCoreClass gives the class of every flat core and mClassCores the cores of every class
+    std::vector<int> mCoreClass;
+    std::vector<std::vector<int>> mClassCores;
+    LaxityBounds mLaxityBounds = {INFINITY, INFINITY};
+}typedef ProblemInstance;
+
+class ThreadPool;
+class TraceBuffer;
+
+//the mutable state of one solve, a context is used by one solve at a time
+//a copy takes the settings but not the worker threads or the trace buffer, so copies of one context can solve at the same time
+struct SolverContext {
+    explicit SolverContext(std::shared_ptr<const ProblemInstance> aInstance) : mInstance(std::move(aInstance)) {}
+
+    SolverContext(const SolverContext& aOther) : SolverContext(nullptr)
+    {
+        *this = aOther;
+    }
+
+    //a field added to the context has to be added here as well
+    SolverContext& operator=(const SolverContext& aOther)
+    {
+        if(this == &aOther)
+            return *this;
+        mInstance = aOther.mInstance;
+        mRng = aOther.mRng;
+        mStart = aOther.mStart;
+        mTimeBudget = aOther.mTimeBudget;
+        mExactTimeLimit = aOther.mExactTimeLimit;
+        mTargetGap = aOther.mTargetGap;
+        mThreadCount = aOther.mThreadCount;
+        mStartTemperature = aOther.mStartTemperature;
+        mIterations = aOther.mIterations;
+        mProgressListener = aOther.mProgressListener;
+        mLog = aOther.mLog;
+        mPool.reset();
+        mTracePath = aOther.mTracePath;
+        mTraceEvery = aOther.mTraceEvery;
+        mTraceBinary = aOther.mTraceBinary;
+        mTraceBuffer.reset();
+        mTraceRun = 0;
+        return *this;
+    }
+
+    std::shared_ptr<const ProblemInstance> mInstance;
+    //every random choice goes through this generator, so seeding it makes a solve repeatable
+    std::mt19937 mRng{std::random_device{}()};
+    //wall clock budget of the search measured from mStart, 0 for none
+    std::chrono::steady_clock::time_point mStart = std::chrono::steady_clock::now();
+    double mTimeBudget = 0;
+    //seconds the exact search may run before it gives up on proving optimality
+    double mExactTimeLimit = 60;
+    //the search stops once the incumbent is within this fraction of the bound, 0 never stops early
+    double mTargetGap = 0;
+    //number of worker threads the parallel engines use
+    unsigned mThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    //temperature the annealing engines start from, a warm start begins much lower so it refines instead of scrambling
+    double mStartTemperature = 30000000;
+    //main loop iterations of the engines, polishing steps and branch and bound nodes
+    long long mIterations = 0;
+    //called with every progress report of the search, a server uses it to pass improvements on to its client
+    std::function<void(const std::string&, double)> mProgressListener;
+    //where the search reports progress
+    std::ostream* mLog = &std::cout;
+    //worker threads of the parallel engines, started on first use and kept for the rest of the solve
+    std::shared_ptr<ThreadPool> mPool;
+    //where runSimulatedAnnealing writes its trace, empty for no trace, and every how many iterations a record is taken
+    //the fields are there in every build so the layout does not depend on SA_TELEMETRY, only that build writes a trace
+    std::string mTracePath;
+    int mTraceEvery = 1;
+    bool mTraceBinary = false;
+    std::shared_ptr<TraceBuffer> mTraceBuffer;
+    int mTraceRun = 0;
+}typedef SolverContext;
+
+//what one solve is asked to do
+struct SolveOptions {
+    //sa rejects neighbours that miss deadlines, penalty lets the search pass through them, tabu, ga and lns run tabu search, the genetic algorithm or large neighbourhood search, exact runs branch and bound
+    std::string mMode = "sa";
+    //run steepest descent on the result of the chosen mode
+    bool mPolish = false;
+    //number of GRASP constructions to seed the search with, 0 starts from the single greedy solution
+    int mGraspCount = 0;
+    //solution file of an earlier run to start from instead of a new construction, the solve fails if it cannot be read or repaired
+    std::string mWarmStart;
+    //changes to the instance, applied to the mWarmStart solution which is then repaired and searched around the changed tasks
+    //the result is written to delta_solution_<output path>
+    std::string mDelta;
+    //write solution_<output path>
+    bool mWriteSolution = true;
+    //put in front of the extension of the solution file, solution_large.3.xml for tag 3, so solves of the same instance
+    //that run at the same time write different files
+    std::string mSolutionTag;
+    //echo the solution to stdout as well
+    bool mPrintSolution = false;
+}typedef SolveOptions;
+
+//what one solve reports
+struct SolveResult {
+    bool mSolved = false;
+    double mLaxity = -INFINITY;
+    double mSeconds = 0;
+    long long mIterations = 0;
+    std::string mSolutionPath;
+    //task position, mcp position and core position of every task, empty if no feasible solution was found
+    std::vector<std::tuple<int, int, int>> mSolution;
+}typedef SolveResult;
+
+//parse a Model file and compute its laxity bounds, nullptr if it cannot be read
+//the tasks of a large file are read on up to aThreadCount threads, 0 for one per hardware thread
+std::shared_ptr<const ProblemInstance> loadInstance(const std::string& aPath, std::ostream& aLog = std::cout, unsigned aThreadCount = 0);
+
+//relative distance between a laxity and the tightest upper bound of the instance
+double optimalityGap(const ProblemInstance& aInstance, double aLaxity);
+
+//aPath with .aTag in front of its extension, large.xml with tag 3 is large.3.xml
+std::string taggedPath(const std::string& aPath, const std::string& aTag);
+
+//whether aMode names an engine of SolveOptions::mMode
+bool isSolveMode(const std::string& aMode);
+
+//search aContext.mInstance and write the solution next to aOutputPath, with a delta the context is moved to the changed instance
+SolveResult solve(SolverContext& aContext, const std::string& aOutputPath, const SolveOptions& aOptions);
+
+#endif
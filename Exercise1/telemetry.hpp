@@ -0,0 +1,118 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+//per-iteration trace of the simulated annealing loop, only compiled in with -DSA_TELEMETRY (make TELEMETRY=1)
+//without it SA_TRACE expands to nothing and the loop is the same as before
+#ifdef SA_TELEMETRY
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+struct TraceRecord {
+    long long mIteration;
+    double mTemperature;
+    double mLaxity;
+    double mBestLaxity;
+    int mSpins;
+    int mRun;
+    unsigned char mAccepted;
+    //0 for a move of one task, 1 for a swap
+    unsigned char mMoveType;
+}typedef TraceRecord;
+
+//fixed size ring buffer, when it is full the oldest records are overwritten so recording never allocates
+//the overwritten records are counted, so a trace that lost its start can say so
+class TraceBuffer
+{
+public:
+    explicit TraceBuffer(size_t aCapacity) : mRecords(aCapacity) {}
+
+    void record(const TraceRecord& aRecord)
+    {
+        mRecords[mNext] = aRecord;
+        mNext = (mNext + 1) % mRecords.size();
+        if(mCount < mRecords.size())
+            mCount++;
+        else
+            mDropped++;
+    }
+
+    //records overwritten since the last flush
+    size_t dropped() const
+    {
+        return mDropped;
+    }
+
+    //write the records oldest first, as CSV with a header or in binary after a "SATRACE2" tag and the record count as a
+    //64-bit integer. A binary record is its fields in declaration order without padding, 42 bytes in the byte order of
+    //the machine: iteration int64, temperature, laxity and best laxity double, spins and run int32, accepted and move type
+    //uint8. aAppend adds to an existing file, the CSV header is then left out
+    bool flush(const std::string& aPath, bool aBinary, bool aAppend)
+    {
+        std::ios::openmode mode = aAppend ? std::ios::app : std::ios::trunc;
+        std::ofstream file(aPath, aBinary ? mode | std::ios::binary : mode);
+        if(!file)
+            return false;
+        file.precision(12);
+
+        size_t first = (mNext + mRecords.size() - mCount) % mRecords.size();
+        if(aBinary)
+        {
+            uint64_t count = mCount;
+            file.write("SATRACE2", 8);
+            writeField(file, count);
+        }
+        else if(!aAppend)
+        {
+            file << "run,iteration,temperature,laxity,best_laxity,accepted,spins,move_type\n";
+        }
+
+        for(size_t k = 0; k < mCount; ++k)
+        {
+            const TraceRecord& record = mRecords[(first + k) % mRecords.size()];
+            if(aBinary)
+            {
+                writeField(file, (int64_t)record.mIteration);
+                writeField(file, record.mTemperature);
+                writeField(file, record.mLaxity);
+                writeField(file, record.mBestLaxity);
+                writeField(file, (int32_t)record.mSpins);
+                writeField(file, (int32_t)record.mRun);
+                writeField(file, (uint8_t)record.mAccepted);
+                writeField(file, (uint8_t)record.mMoveType);
+            }
+            else
+                file << record.mRun << ',' << record.mIteration << ',' << record.mTemperature << ',' << record.mLaxity << ',' << record.mBestLaxity << ','
+                     << (int)record.mAccepted << ',' << record.mSpins << ',' << (record.mMoveType ? "swap" : "move") << '\n';
+        }
+
+        mNext = 0;
+        mCount = 0;
+        mDropped = 0;
+        return true;
+    }
+
+private:
+    template<class T>
+    static void writeField(std::ofstream& aFile, T aValue)
+    {
+        aFile.write(reinterpret_cast<const char*>(&aValue), sizeof(aValue));
+    }
+
+    std::vector<TraceRecord> mRecords;
+    size_t mNext = 0;
+    size_t mCount = 0;
+    size_t mDropped = 0;
+};
+
+#define SA_TRACE(statement) statement
+
+#else
+
+#define SA_TRACE(statement)
+
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//fixed set of worker threads that share out the indices of a loop, only one loop may run on a pool at a time
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned aThreadCount)
+    {
+        for(unsigned i = 0; i < aThreadCount; ++i)
+            mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWake.notify_all();
+        for(auto& worker : mWorkers)
+            worker.join();
+    }
+
+    unsigned threadCount() const
+    {
+        return mWorkers.size();
+    }
+
+    //runs aJob(i) for every i in [0, aCount) and returns once all of them are done
+    void parallelFor(int aCount, const std::function<void(int)>& aJob)
+    {
+        if(mWorkers.empty())
+        {
+            for(int i = 0; i < aCount; ++i)
+                aJob(i);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mJob = &aJob;
+        mCount = aCount;
+        mNext = 0;
+        mActive = mWorkers.size();
+        mGeneration++;
+        mWake.notify_all();
+        mDone.wait(lock, [this]{ return mActive == 0; });
+        mJob = nullptr;
+    }
+
+private:
+    void workerLoop()
+    {
+        unsigned seenGeneration = 0;
+        while(true)
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this, &seenGeneration]{ return mStop || mGeneration != seenGeneration; });
+            if(mStop)
+                return;
+            seenGeneration = mGeneration;
+            const std::function<void(int)>* job = mJob;
+            int count = mCount;
+            lock.unlock();
+
+            for(int i = mNext++; i < count; i = mNext++)
+                (*job)(i);
+
+            lock.lock();
+            if(--mActive == 0)
+                mDone.notify_one();
+        }
+    }
+
+    std::vector<std::thread> mWorkers;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    const std::function<void(int)>* mJob = nullptr;
+    std::atomic<int> mNext{0};
+    int mCount = 0;
+    int mActive = 0;
+    unsigned mGeneration = 0;
+    bool mStop = false;
+};
+
+#endif
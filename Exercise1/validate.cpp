@@ -0,0 +1,143 @@
+#include "solver.hpp"
+#include "pugixml.hpp"
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+
+//checks a solution file against its Model: every task assigned exactly once to an MCP and core that exist, every core used,
+//every core schedulable under EDF (load at most 1, the same test the solver uses), and the WCRT of every task and the
+//Total Laxity comment equal to the recomputed values
+//
+//  Validator large.xml solution_large.xml
+
+//only the first few problems of every run are printed, a broken million task file would otherwise flood the terminal
+const int maxReported = 20;
+
+int problems = 0;
+
+void report(const std::string& aProblem)
+{
+    if(problems++ < maxReported)
+        std::cout << aProblem << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc != 3)
+    {
+        std::cout << "Usage: Validator MODEL.xml SOLUTION.xml" << std::endl;
+        return -1;
+    }
+
+    std::shared_ptr<const ProblemInstance> model = loadInstance(argv[1]);
+    if(!model)
+        return -1;
+    const ProblemInstance& instance = *model;
+
+    pugi::xml_document doc;
+    if(!doc.load_file(argv[2], pugi::parse_default | pugi::parse_comments))
+    {
+        std::cout << "Could not read " << argv[2] << std::endl;
+        return -1;
+    }
+
+    //ids to positions, the ids in the files do not have to start at 0 or be contiguous
+    std::unordered_map<int, int> taskIndex;
+    taskIndex.reserve(instance.mTasks.size());
+    for(unsigned i = 0; i < instance.mTasks.size(); ++i)
+        taskIndex[instance.mTasks[i].mId] = i;
+    std::unordered_map<int, int> mcpIndex;
+    std::vector<std::unordered_map<int, int>> coreIndex(instance.mPlatform.size());
+    for(unsigned m = 0; m < instance.mPlatform.size(); ++m)
+    {
+        mcpIndex[instance.mPlatform[m].mId] = m;
+        for(unsigned c = 0; c < instance.mPlatform[m].mCores.size(); ++c)
+            coreIndex[m][instance.mPlatform[m].mCores[c].mId] = c;
+    }
+
+    //the core state is built up entry by entry, so the whole check is one pass over the file
+    CoreState state;
+    state.mLoads.assign(instance.mCoreCount, 0.0);
+    state.mTaskCounts.assign(instance.mCoreCount, 0);
+    std::vector<char> assigned(instance.mTasks.size(), 0);
+    double laxity = instance.mDeadlineSum;
+
+    pugi::xml_node root = doc.child("solution") ? doc.child("solution") : doc.child("Solution");
+    for(pugi::xml_node entry : root.children("Task"))
+    {
+        int id = entry.attribute("Id").as_int();
+        int mcpId = entry.attribute("MCP").as_int();
+        int coreId = entry.attribute("Core").as_int();
+
+        auto task = taskIndex.find(id);
+        if(task == taskIndex.end())
+        {
+            report("Task " + std::to_string(id) + " is not in the model");
+            continue;
+        }
+        if(assigned[task->second]++)
+        {
+            report("Task " + std::to_string(id) + " is assigned more than once");
+            continue;
+        }
+        auto mcp = mcpIndex.find(mcpId);
+        if(mcp == mcpIndex.end())
+        {
+            report("Task " + std::to_string(id) + " is on MCP " + std::to_string(mcpId) + " which does not exist");
+            continue;
+        }
+        auto core = coreIndex[mcp->second].find(coreId);
+        if(core == coreIndex[mcp->second].end())
+        {
+            report("Task " + std::to_string(id) + " is on core " + std::to_string(coreId) + " of MCP " + std::to_string(mcpId) + " which does not exist");
+            continue;
+        }
+
+        int flat = instance.mCoreOffset[mcp->second] + core->second;
+        double executionTime = instance.mTasks[task->second].mWcet * coreFactor(instance, flat);
+        state.mLoads[flat] += taskLoad(instance, task->second, mcp->second, core->second);
+        state.mTaskCounts[flat]++;
+        laxity -= executionTime;
+
+        long long wcrt = entry.attribute("WCRT").as_llong();
+        if(wcrt != llround(executionTime))
+            report("Task " + std::to_string(id) + " reports WCRT " + std::to_string(wcrt) + ", recomputed " + std::to_string(llround(executionTime)));
+    }
+
+    for(unsigned i = 0; i < instance.mTasks.size(); ++i)
+    {
+        if(!assigned[i])
+            report("Task " + std::to_string(instance.mTasks[i].mId) + " is not assigned");
+    }
+
+    for(int flat = 0; flat < instance.mCoreCount; ++flat)
+    {
+        std::string name = "Core " + std::to_string(instance.mPlatform[instance.mFlatCores[flat].first].mCores[instance.mFlatCores[flat].second].mId) + " of MCP " + std::to_string(instance.mPlatform[instance.mFlatCores[flat].first].mId);
+        if(state.mTaskCounts[flat] == 0)
+            report(name + " has no task");
+        if(state.mLoads[flat] > 1.0 + loadTolerance)
+            report(name + " misses deadlines, load " + std::to_string(state.mLoads[flat]));
+    }
+
+    //the laxity is written as a comment after the solution element
+    long long reported = 0;
+    bool found = false;
+    for(pugi::xml_node node : doc.children())
+    {
+        if(node.type() == pugi::node_comment && sscanf(node.value(), " Total Laxity: %lld", &reported) == 1)
+            found = true;
+    }
+    if(!found)
+        report("No Total Laxity comment");
+    else if(reported != llround(laxity))
+        report("Total Laxity is " + std::to_string(reported) + ", recomputed " + std::to_string(llround(laxity)));
+
+    if(problems > maxReported)
+        std::cout << "... " << problems - maxReported << " more" << std::endl;
+    std::cout << argv[2] << (problems ? ": INVALID, " + std::to_string(problems) + " problems" : ": valid, total laxity " + std::to_string(llround(laxity))) << std::endl;
+    return problems ? 1 : 0;
+}